@@ -3,13 +3,68 @@
 #include <QtCore/QCommandLineOption>
 #include <QtCore/QDebug>
 #include "../web/MainWindow.h"
+#include "../web/SebSchemeHandler.h"
+#include "../core/AuditLog.h"
 #include "../core/ConfigLoader.h"
+#include "../core/Logging.h"
+#include "../core/ProxyConfig.h"
+#include "../core/ResourceProfile.h"
+#include "../core/StartupTrace.h"
+
+// --trace-startup and --config have to be known before QApplication exists
+// (the resource profile configures Chromium through the environment), so
+// they are picked from argv directly; QCommandLineParser validates them later
+static QString earlyOptionValue(int argc, char *argv[], const QByteArray& longName, const QByteArray& shortName = QByteArray())
+{
+    for (int i = 1; i < argc; ++i) {
+        QByteArray arg(argv[i]);
+        if ((arg == longName || (!shortName.isEmpty() && arg == shortName)) && i + 1 < argc) {
+            return QString::fromLocal8Bit(argv[i + 1]);
+        }
+        if (arg.startsWith(longName + "=")) {
+            return QString::fromLocal8Bit(arg.mid(longName.size() + 1));
+        }
+        if (!shortName.isEmpty() && arg.startsWith(shortName) && !arg.startsWith("--") && arg.size() > shortName.size()) {
+            return QString::fromLocal8Bit(arg.mid(shortName.size()));
+        }
+    }
+    return QString();
+}
 
 int main(int argc, char *argv[])
 {
+    // Log through the background writer from the very start
+    seb::core::AsyncLog::install();
+
+    seb::core::StartupTrace& trace = seb::core::StartupTrace::instance();
+    trace.enable(earlyOptionValue(argc, argv, "--trace-startup"));
+
+    // Set before loading the config: standard paths depend on them
+    QCoreApplication::setApplicationName("seb-linux");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    // Load configuration
+    QString configPath = earlyOptionValue(argc, argv, "--config", "-c");
+    seb::core::ConfigLoadResult result;
+    if (!configPath.isEmpty()) {
+        qint64 configStart = trace.now();
+        result = seb::core::ConfigLoader::loadFromFile(configPath);
+        trace.addSpan("ConfigLoader::loadFromFile", configStart, trace.now());
+
+        // Process model, memory limits and proxy have to be in place
+        // before QtWebEngine initializes
+        if (result.success) {
+            seb::core::ResourceProfile::apply(result.policy.resources);
+            seb::core::ProxyConfig::apply(result.policy.proxy);
+        }
+    }
+
+    // Custom schemes have to be known before QtWebEngine initializes
+    seb::web::SebSchemeHandler::registerScheme();
+
+    qint64 appStart = trace.now();
     QApplication app(argc, argv);
-    app.setApplicationName("seb-linux");
-    app.setApplicationVersion("1.0.0");
+    trace.addSpan("QApplication", appStart, trace.now());
 
     // Detect session type (Wayland/X11)
     QString sessionType = qEnvironmentVariable("XDG_SESSION_TYPE");
@@ -31,7 +86,7 @@ int main(int argc, char *argv[])
     parser.addVersionOption();
 
     QCommandLineOption configOption(QStringList() << "c" << "config",
-                                     "Path to JSON configuration file",
+                                     "Path to JSON or .seb configuration file",
                                      "config-file");
     parser.addOption(configOption);
 
@@ -39,19 +94,21 @@ int main(int argc, char *argv[])
                                           "Password required to quit the application",
                                           "password");
     parser.addOption(quitPasswordOption);
+
+    QCommandLineOption traceStartupOption("trace-startup",
+                                          "Write a Chrome trace-event JSON of startup stages to <file>",
+                                          "file");
+    parser.addOption(traceStartupOption);
     
     parser.process(app);
 
-    // Get config file path
-    QString configPath = parser.value(configOption);
-    if (configPath.isEmpty()) {
+    // The config was loaded before QApplication; check it was the one given
+    if (configPath.isEmpty() || parser.value(configOption) != configPath) {
         qCritical() << "Error: --config option is required";
         qCritical() << parser.helpText();
         return 1;
     }
 
-    // Load configuration
-    seb::core::ConfigLoadResult result = seb::core::ConfigLoader::loadFromFile(configPath);
     if (!result.success) {
         qCritical() << "Error: Failed to load configuration from:" << configPath;
         qCritical() << "Error details:" << result.errorMessage;
@@ -65,7 +122,7 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    qDebug() << "Configuration loaded successfully";
+    qDebug() << "Configuration loaded successfully in" << result.parseTimeMs << "ms";
     qDebug() << "Start URL:" << policy.startUrl;
     qDebug() << "Allowed domains:" << policy.allowedDomains;
     if (!policy.clientVersion.isEmpty()) {
@@ -75,13 +132,37 @@ int main(int argc, char *argv[])
         qDebug() << "Client type:" << policy.clientType;
     }
 
+    // Start the audit log before the first navigation
+    if (!policy.auditLogPath.isEmpty() && !seb::core::AuditLog::instance().open(policy.auditLogPath)) {
+        qCritical() << "Error: Failed to open audit log:" << policy.auditLogPath;
+        return 1;
+    }
+
     // Get quit password if provided
     QString quitPassword = parser.value(quitPasswordOption);
     
+    // Write whatever was traced if the first load never finishes
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [&trace]() {
+        trace.finish();
+    });
+
     // Create and show main window
+    qint64 windowStart = trace.now();
     seb::web::MainWindow window(policy, quitPassword);
+    if (!window.startupError().isEmpty()) {
+        qCritical() << "Error: Policy cannot be enforced:" << window.startupError();
+        seb::core::AuditLog::instance().close();
+        return 1;
+    }
+    if (policy.reloadOnChange) {
+        window.watchPolicyFile(configPath);
+    }
     window.show();
+    trace.addSpan("MainWindow", windowStart, trace.now());
 
-    return app.exec();
+    int exitCode = app.exec();
+    seb::core::AuditLog::instance().close();
+    seb::core::AsyncLog::shutdown();
+    return exitCode;
 }
 
@@ -0,0 +1,427 @@
+#include "AuditLog.h"
+#include "Logging.h"
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QTimeZone>
+#include <QtCore/QtEndian>
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+constexpr quint32 BlockMagic = 0x41424553; // "SEBA"
+constexpr quint32 FormatVersion = 1;
+
+enum BlockKind : quint16 {
+    SessionBlock = 1,
+    RecordBlock = 2,
+    StringBlock = 3
+};
+
+// Block header: magic u32, kind u16, reserved u16, used u32, crc u32, index u64
+constexpr int HeaderSize = 24;
+constexpr int PayloadSize = AuditLog::BlockSize - HeaderSize;
+constexpr int MagicOffset = 0;
+constexpr int KindOffset = 4;
+constexpr int UsedOffset = 8;
+constexpr int CrcOffset = 12;
+constexpr int IndexOffset = 16;
+
+// Session payload: version u32, block size u32, start time (ms) i64, pid u32, reserved u32
+constexpr int SessionSize = 24;
+
+// Record: time (us) i64, origin id u32, path id u32, sequence u32, event u8, detail u8, reserved u16
+constexpr int RecordSize = 24;
+
+// String entry: id u32, length u16, UTF-8 bytes
+constexpr int StringHeaderSize = 6;
+constexpr int MaxStringSize = 1024;
+
+// Strings remembered per session; later new strings are written with every
+// record using them, so pages with unique paths cannot grow memory
+constexpr int MaxInternedStrings = 4096;
+
+constexpr qint64 GrowBlocks = 256; // 1 MB
+
+qint64 currentTimeUs() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+quint32 crcOf(quint32 crc, const uchar* data, int size) {
+    return quint32(crc32(uLong(crc), data, uInt(size)));
+}
+
+// UTF-8 of value cut to maxSize bytes without splitting a character
+QByteArray truncatedUtf8(const QString& value, int maxSize) {
+    QByteArray utf8 = value.toUtf8();
+    if (utf8.size() > maxSize) {
+        qsizetype end = maxSize;
+        while (end > 0 && (uchar(utf8[end]) & 0xC0) == 0x80) {
+            --end;
+        }
+        utf8.truncate(end);
+    }
+    return utf8;
+}
+
+QString utcTime(qint64 msecsSinceEpoch) {
+    return QDateTime::fromMSecsSinceEpoch(msecsSinceEpoch, QTimeZone::utc()).toString(Qt::ISODateWithMs);
+}
+
+} // namespace
+
+AuditLog& AuditLog::instance() {
+    static AuditLog log;
+    return log;
+}
+
+AuditLog::AuditLog()
+    : m_open(false)
+    , m_map(nullptr)
+    , m_blockCount(0)
+    , m_nextBlock(0)
+    , m_recordBlock(-1)
+    , m_stringBlock(-1)
+    , m_sequence(0)
+    , m_nextStringId(1)
+{
+}
+
+AuditLog::~AuditLog() {
+    close();
+}
+
+bool AuditLog::open(const QString& path) {
+    close();
+
+    QMutexLocker locker(&m_mutex);
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qCWarning(lcConfig) << "Cannot open audit log" << path << ":" << m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    if (size % BlockSize != 0) {
+        qCWarning(lcConfig) << "Not a seb-linux audit log (unexpected size):" << path;
+        m_file.close();
+        return false;
+    }
+
+    m_blockCount = size / BlockSize;
+    m_map = m_blockCount > 0 ? m_file.map(0, size) : nullptr;
+    if (m_blockCount > 0 && !m_map) {
+        qCWarning(lcConfig) << "Cannot map audit log" << path << ":" << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    // Append after the last written block of earlier sessions
+    m_nextBlock = 0;
+    while (m_nextBlock < m_blockCount && qFromLittleEndian<quint32>(block(m_nextBlock) + MagicOffset) == BlockMagic) {
+        ++m_nextBlock;
+    }
+    if (m_nextBlock > 0 && qFromLittleEndian<quint16>(block(0) + KindOffset) != SessionBlock) {
+        qCWarning(lcConfig) << "Not a seb-linux audit log:" << path;
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_file.close();
+        return false;
+    }
+
+    m_strings.clear();
+    m_recordBlock = -1;
+    m_stringBlock = -1;
+    m_sequence = 0;
+    m_nextStringId = 1;
+
+    uchar session[SessionSize] = {};
+    qToLittleEndian<quint32>(FormatVersion, session);
+    qToLittleEndian<quint32>(quint32(BlockSize), session + 4);
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), session + 8);
+    qToLittleEndian<quint32>(quint32(::getpid()), session + 16);
+    qint64 sessionBlock = -1;
+    if (!append(sessionBlock, SessionBlock, session, SessionSize)) {
+        m_file.close();
+        return false;
+    }
+
+    m_open.store(true, std::memory_order_release);
+    locker.unlock();
+
+    record(Event::SessionStart);
+    qCDebug(lcConfig) << "Audit log:" << path;
+    return true;
+}
+
+void AuditLog::close() {
+    QMutexLocker locker(&m_mutex);
+    m_open.store(false, std::memory_order_release);
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    // Drop the unused preallocated tail
+    m_file.resize(m_nextBlock * BlockSize);
+    m_file.close();
+    m_blockCount = 0;
+}
+
+void AuditLog::record(Event event, const QUrl& url, quint8 detail) {
+    if (!isOpen()) {
+        return;
+    }
+
+    const qint64 timestampUs = currentTimeUs();
+    QString origin;
+    QString path;
+    if (!url.isEmpty()) {
+        origin = url.adjusted(QUrl::RemoveUserInfo | QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment)
+                     .toString(QUrl::FullyEncoded);
+        path = url.path(QUrl::FullyEncoded);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_open.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uchar record[RecordSize] = {};
+    qToLittleEndian<qint64>(timestampUs, record);
+    qToLittleEndian<quint32>(intern(origin), record + 8);
+    qToLittleEndian<quint32>(intern(path), record + 12);
+    qToLittleEndian<quint32>(++m_sequence, record + 16);
+    record[20] = quint8(event);
+    record[21] = detail;
+    append(m_recordBlock, RecordBlock, record, RecordSize);
+}
+
+QString AuditLog::eventName(Event event) {
+    switch (event) {
+    case Event::SessionStart:
+        return "session_start";
+    case Event::NavigationAllowed:
+        return "navigation_allowed";
+    case Event::NavigationBlocked:
+        return "navigation_blocked";
+    case Event::RequestBlocked:
+        return "request_blocked";
+    case Event::PopupBlocked:
+        return "popup_blocked";
+    case Event::DownloadBlocked:
+        return "download_blocked";
+    case Event::PrintBlocked:
+        return "print_blocked";
+    }
+    return QString("unknown_%1").arg(int(event));
+}
+
+uchar* AuditLog::block(qint64 index) const {
+    return m_map + index * BlockSize;
+}
+
+bool AuditLog::ensureSize(qint64 blockCount) {
+    if (blockCount <= m_blockCount) {
+        return true;
+    }
+
+    const qint64 newCount = (blockCount + GrowBlocks - 1) / GrowBlocks * GrowBlocks;
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (!m_file.resize(newCount * BlockSize) || !(m_map = m_file.map(0, newCount * BlockSize))) {
+        qCWarning(lcConfig) << "Audit log stopped, cannot grow file:" << m_file.errorString();
+        m_open.store(false, std::memory_order_release);
+        m_blockCount = 0;
+        return false;
+    }
+    m_blockCount = newCount;
+    return true;
+}
+
+qint64 AuditLog::allocateBlock(quint16 kind) {
+    if (!ensureSize(m_nextBlock + 1)) {
+        return -1;
+    }
+
+    uchar* header = block(m_nextBlock);
+    qToLittleEndian<quint16>(kind, header + KindOffset);
+    qToLittleEndian<quint32>(0, header + UsedOffset);
+    qToLittleEndian<quint32>(crcOf(0, nullptr, 0), header + CrcOffset);
+    qToLittleEndian<quint64>(quint64(m_nextBlock), header + IndexOffset);
+    // Magic last: a torn header is not mistaken for a block
+    qToLittleEndian<quint32>(BlockMagic, header + MagicOffset);
+    return m_nextBlock++;
+}
+
+bool AuditLog::append(qint64& blockIndex, quint16 kind, const void* data, int size) {
+    if (blockIndex < 0 || int(qFromLittleEndian<quint32>(block(blockIndex) + UsedOffset)) + size > PayloadSize) {
+        blockIndex = allocateBlock(kind);
+        if (blockIndex < 0) {
+            return false;
+        }
+    }
+
+    uchar* header = block(blockIndex);
+    const quint32 used = qFromLittleEndian<quint32>(header + UsedOffset);
+    std::memcpy(header + HeaderSize + used, data, size_t(size));
+
+    // Incremental CRC over the payload written so far
+    const quint32 crc = crcOf(qFromLittleEndian<quint32>(header + CrcOffset),
+                              static_cast<const uchar*>(data), size);
+    qToLittleEndian<quint32>(crc, header + CrcOffset);
+    qToLittleEndian<quint32>(used + quint32(size), header + UsedOffset);
+    return true;
+}
+
+quint32 AuditLog::intern(const QString& value) {
+    if (value.isEmpty()) {
+        return 0;
+    }
+    auto it = m_strings.constFind(value);
+    if (it != m_strings.constEnd()) {
+        return it.value();
+    }
+
+    const QByteArray utf8 = truncatedUtf8(value, MaxStringSize);
+    const quint32 id = m_nextStringId;
+
+    uchar entry[StringHeaderSize + MaxStringSize];
+    qToLittleEndian<quint32>(id, entry);
+    qToLittleEndian<quint16>(quint16(utf8.size()), entry + 4);
+    std::memcpy(entry + StringHeaderSize, utf8.constData(), size_t(utf8.size()));
+    if (!append(m_stringBlock, StringBlock, entry, StringHeaderSize + int(utf8.size()))) {
+        return 0;
+    }
+
+    ++m_nextStringId;
+    if (m_strings.size() < MaxInternedStrings) {
+        m_strings.insert(value, id);
+    }
+    return id;
+}
+
+QJsonObject AuditLogReader::toJson(const QString& path, QString* errorString) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return QJsonObject();
+    }
+
+    const qint64 size = file.size();
+    const uchar* data = size > 0 ? file.map(0, size) : nullptr;
+    if (size % AuditLog::BlockSize != 0 || (size > 0 && !data)) {
+        if (errorString) {
+            *errorString = "Not a seb-linux audit log";
+        }
+        return QJsonObject();
+    }
+
+    struct Session {
+        QJsonObject info;
+        QHash<quint32, QString> strings;
+        QList<const uchar*> records;
+    };
+    QList<Session> sessions;
+    int corruptBlocks = 0;
+
+    for (qint64 index = 0; index < size / AuditLog::BlockSize; ++index) {
+        const uchar* header = data + index * AuditLog::BlockSize;
+        if (qFromLittleEndian<quint32>(header + MagicOffset) != BlockMagic) {
+            break; // Unused preallocated space
+        }
+
+        const quint16 kind = qFromLittleEndian<quint16>(header + KindOffset);
+        const quint32 used = qFromLittleEndian<quint32>(header + UsedOffset);
+        const uchar* payload = header + HeaderSize;
+        if (used > quint32(PayloadSize)
+            || qFromLittleEndian<quint64>(header + IndexOffset) != quint64(index)
+            || crcOf(0, payload, int(used)) != qFromLittleEndian<quint32>(header + CrcOffset)) {
+            ++corruptBlocks;
+            continue;
+        }
+
+        if (kind == SessionBlock && used >= quint32(SessionSize)) {
+            Session session;
+            const qint64 startedAtMs = qFromLittleEndian<qint64>(payload + 8);
+            session.info["startedAt"] = utcTime(startedAtMs);
+            session.info["pid"] = qint64(qFromLittleEndian<quint32>(payload + 16));
+            session.info["version"] = qint64(qFromLittleEndian<quint32>(payload));
+            sessions.append(session);
+            continue;
+        }
+        if (sessions.isEmpty()) {
+            ++corruptBlocks;
+            continue;
+        }
+
+        Session& session = sessions.last();
+        if (kind == StringBlock) {
+            quint32 offset = 0;
+            while (offset + StringHeaderSize <= used) {
+                const quint32 id = qFromLittleEndian<quint32>(payload + offset);
+                const quint16 length = qFromLittleEndian<quint16>(payload + offset + 4);
+                if (offset + StringHeaderSize + length > used) {
+                    break;
+                }
+                session.strings.insert(id, QString::fromUtf8(
+                    reinterpret_cast<const char*>(payload + offset + StringHeaderSize), length));
+                offset += StringHeaderSize + length;
+            }
+        } else if (kind == RecordBlock) {
+            for (quint32 offset = 0; offset + RecordSize <= used; offset += RecordSize) {
+                session.records.append(payload + offset);
+            }
+        }
+    }
+
+    // Records may reference strings from later blocks of the same session
+    QJsonArray sessionArray;
+    for (const Session& session : std::as_const(sessions)) {
+        QJsonArray events;
+        for (const uchar* record : session.records) {
+            const qint64 timestampUs = qFromLittleEndian<qint64>(record);
+            QJsonObject event;
+            event["seq"] = qint64(qFromLittleEndian<quint32>(record + 16));
+            event["time"] = utcTime(timestampUs / 1000);
+            event["event"] = AuditLog::eventName(AuditLog::Event(record[20]));
+            const QString origin = session.strings.value(qFromLittleEndian<quint32>(record + 8));
+            if (!origin.isEmpty()) {
+                event["origin"] = origin;
+            }
+            const QString recordPath = session.strings.value(qFromLittleEndian<quint32>(record + 12));
+            if (!recordPath.isEmpty()) {
+                event["path"] = recordPath;
+            }
+            event["detail"] = int(record[21]);
+            events.append(event);
+        }
+
+        QJsonObject object = session.info;
+        object["events"] = events;
+        sessionArray.append(object);
+    }
+
+    QJsonObject root;
+    root["sessions"] = sessionArray;
+    root["corruptBlocks"] = corruptBlocks;
+    return root;
+}
+
+} // namespace core
+} // namespace seb
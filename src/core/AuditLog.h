@@ -0,0 +1,87 @@
+#ifndef SEB_CORE_AUDIT_LOG_H
+#define SEB_CORE_AUDIT_LOG_H
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <QtCore/QtGlobal>
+#include <atomic>
+
+namespace seb {
+namespace core {
+
+// Append-only binary audit log of navigation and blocking events.
+//
+// The file is a sequence of 4 KB blocks, memory-mapped and grown in 1 MB
+// steps. Each block has a header (magic, kind, used bytes, CRC-32 of the
+// used payload, block index) followed by either fixed-size 24-byte event
+// records or string table entries. Origins ("https://host:port") and paths
+// are interned per session, so an event costs one hash lookup, a memcpy
+// and an incremental CRC update; no text is formatted. The intern table is
+// capped; strings first seen after that are written again on every use.
+// Strings are cut to 1 KB on a UTF-8 character boundary. Every session starts
+// with a session block, so one file can hold several runs. All integers
+// are little-endian. Query strings and fragments are never recorded.
+class AuditLog {
+public:
+    enum class Event : quint8 {
+        SessionStart = 1,
+        NavigationAllowed = 2,
+        NavigationBlocked = 3,
+        RequestBlocked = 4,
+        PopupBlocked = 5,
+        DownloadBlocked = 6,
+        PrintBlocked = 7
+    };
+
+    static constexpr int BlockSize = 4096;
+
+    static AuditLog& instance();
+
+    // Open (or append to) the audit log; returns false and logs on error
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_open.load(std::memory_order_acquire); }
+
+    // Thread-safe; detail is event specific (navigation or resource type)
+    void record(Event event, const QUrl& url = QUrl(), quint8 detail = 0);
+
+    static QString eventName(Event event);
+
+private:
+    AuditLog();
+    ~AuditLog();
+
+    uchar* block(qint64 index) const;
+    qint64 allocateBlock(quint16 kind);
+    bool append(qint64& blockIndex, quint16 kind, const void* data, int size);
+    quint32 intern(const QString& value);
+    bool ensureSize(qint64 blockCount);
+
+    QMutex m_mutex;
+    std::atomic<bool> m_open;
+    QFile m_file;
+    uchar* m_map;
+    qint64 m_blockCount;          // Blocks in the mapped file
+    qint64 m_nextBlock;           // First unused block
+    qint64 m_recordBlock;         // Block receiving records (-1: none)
+    qint64 m_stringBlock;         // Block receiving strings (-1: none)
+    quint32 m_sequence;
+    quint32 m_nextStringId;
+    QHash<QString, quint32> m_strings;
+};
+
+// Decoder for audit log files
+class AuditLogReader {
+public:
+    // {"sessions": [{"startedAt", "pid", "events": [...]}], "corruptBlocks": n}
+    static QJsonObject toJson(const QString& path, QString* errorString = nullptr);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_AUDIT_LOG_H
@@ -5,6 +5,24 @@ namespace core {
 
 // Policy struct implementation - mostly inline in header
 
+ResourceSettings ResourceSettings::lowMemory() {
+    ResourceSettings settings;
+    settings.processModel = "process-per-site";
+    settings.rendererProcessLimit = 2;
+    settings.jsHeapLimitMb = 512;
+    settings.disabledFeatures = {
+        "BackForwardCache",
+        "SpareRendererForSitePerProcess",
+        "MediaRouter",
+        "OptimizationHints",
+        "Translate",
+        "AutofillServerCommunication",
+    };
+    settings.disableBackgroundNetworking = true;
+    settings.httpCacheMb = 64;
+    return settings;
+}
+
 } // namespace core
 } // namespace seb
 
@@ -1,13 +1,112 @@
 #ifndef SEB_CORE_CONFIG_H
 #define SEB_CORE_CONFIG_H
 
+#include <QtCore/QList>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QUrl>
+#include <memory>
 
 namespace seb {
 namespace core {
 
+class PolicyBlob;
+
+// Optional background warm-up of the HTTP cache before the exam starts
+struct PrefetchSettings {
+    QStringList urls;              // Assets to fetch
+    QString manifestUrl;           // Optional: HTTPS URL listing more assets
+    int concurrency = 4;           // Parallel requests (1-16)
+    int jitterMs = 30000;          // Random start delay window in milliseconds
+
+    bool isEnabled() const {
+        return !urls.isEmpty() || !manifestUrl.isEmpty();
+    }
+};
+
+// Admission control for the initial page load
+struct StartLoadSettings {
+    int spreadMs = 0;              // Random delay window before the first load
+    int maxRetries = 8;            // Retries of a failed start page load
+    int initialBackoffMs = 2000;   // First retry delay, doubled per attempt
+    int maxBackoffMs = 60000;      // Upper bound for the retry delay
+};
+
+// Local metrics export in the Prometheus text format
+struct MetricsSettings {
+    QString textfilePath;          // Optional: File rewritten every intervalMs
+    QString socketPath;            // Optional: Unix socket serving the metrics
+    int intervalMs = 15000;        // Textfile update interval in milliseconds
+
+    bool isEnabled() const {
+        return !textfilePath.isEmpty() || !socketPath.isEmpty();
+    }
+};
+
+// Chromium process model and memory limits, applied before QApplication
+struct ResourceSettings {
+    QString processModel;          // Optional: "process-per-site-instance" (default) or "process-per-site"
+    int rendererProcessLimit = 0;  // Maximum renderer processes (0 = Chromium default)
+    int jsHeapLimitMb = 0;         // V8 old generation limit per renderer (0 = default)
+    QStringList disabledFeatures;  // Chromium features passed to --disable-features
+    bool disableBackgroundNetworking = false;
+    int httpCacheMb = 0;           // HTTP disk cache limit (0 = Chromium default)
+    int memoryReportIntervalMs = 0; // Log resident memory per process (0 = off)
+
+    // Preset for 4 GB lab machines; explicit fields override it
+    static ResourceSettings lowMemory();
+};
+
+// Proxy for all browser traffic, applied before QtWebEngine initializes
+struct ProxySettings {
+    QString mode = "system";       // "system", "direct", "fixed" or "pac"
+    QString server;                // "fixed": scheme://host:port (http, https, socks4, socks5)
+    QString pacUrl;                // "pac": http(s), file or data URL of the PAC script
+    QStringList bypass;            // "fixed": Hosts (and their subdomains) reached directly
+};
+
+// Script injected into every frame of every page
+struct UserScript {
+    QString path;                  // JavaScript file, absolute
+    bool mainWorld = false;        // Run in the page's world instead of an isolated one
+    bool atDocumentReady = false;  // Run on DOMContentLoaded instead of document creation
+};
+
+// In-page lockdown, applied through user scripts
+struct LockdownSettings {
+    bool blockContextMenu = true;
+    bool blockTextSelection = false;
+    bool blockClipboard = false;   // copy, cut and paste events
+    QList<UserScript> userScripts; // Optional: Additional scripts from files
+};
+
+// SEB-style URL filter rule
+struct UrlFilterRule {
+    enum class Action {
+        Block = 0,
+        Allow = 1
+    };
+
+    QString expression;            // Wildcard expression or regular expression
+    bool regex = false;            // Treat expression as a regular expression
+    bool active = true;            // Inactive rules are ignored
+    Action action = Action::Allow;
+};
+
+// Rule for subresource requests of given types, evaluated after the
+// allowlist and URL filter have let the request through
+struct ResourceRule {
+    enum class Action {
+        Block = 0,
+        Allow = 1
+    };
+
+    QStringList types;             // Resource type names ("media", "font", "xhr", ...)
+    QStringList domains;           // Optional: Hosts and their subdomains; empty matches all
+    bool thirdPartyOnly = false;   // Only requests to a different site than the page
+    Action action = Action::Block;
+};
+
 struct Policy {
     QString startUrl;              // Required: HTTPS URL
     QStringList allowedDomains;    // List of allowed domains
@@ -15,6 +114,24 @@ struct Policy {
     QString clientVersion;         // Optional: Client version (defaults to "0.1.0")
     QString clientType;           // Optional: Client type (defaults to "SEB-Linux")
     bool sendConfigKey = true;     // Default: true
+    QString browserExamKey;        // Optional: Browser exam key (hex) for X-SafeExamBrowser-RequestHash
+    QString configKey;             // Config key (hex) for X-SafeExamBrowser-ConfigKeyHash
+    PrefetchSettings prefetch;     // Optional: HTTP cache warm-up
+    StartLoadSettings startLoad;   // Optional: Start page load spreading and retries
+    QList<UrlFilterRule> urlFilterRules; // Optional: Ordered URL rules, first match wins
+    QList<ResourceRule> resourceRules;   // Optional: Ordered per resource type rules, first match wins
+    bool reloadOnChange = false;   // Default: false; apply allowlist/filter edits live
+    QString auditLogPath;          // Optional: Binary audit log of navigation/blocking events
+    MetricsSettings metrics;       // Optional: Counters and latency histograms export
+    ResourceSettings resources;    // Optional: Process model and memory limits
+    ProxySettings proxy;           // Optional: Proxy server or PAC script
+    LockdownSettings lockdown;     // Optional: In-page lockdown scripts
+    QStringList blockedShortcuts = { // Key combinations swallowed application-wide
+        "Ctrl+P", "Ctrl+S", "Ctrl+L", "Ctrl+T", "Ctrl+N", "Ctrl+W", "Ctrl+Shift+I", "F11"
+    };
+    // Set when loaded from a seb-policyc blob: prebuilt tables for the
+    // fields above, used instead of rebuilding them
+    std::shared_ptr<const PolicyBlob> compiled;
 
     bool isValid() const {
         if (startUrl.isEmpty()) {
@@ -0,0 +1,159 @@
+#include "ConfigKey.h"
+#include "Sha256.h"
+#include <QtCore/QJsonArray>
+#include <QtCore/QLocale>
+#include <QtCore/QStringList>
+#include <QtCore/QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+// Writes the canonical serialization through a fixed buffer into SHA-256
+class CanonicalJsonHasher {
+public:
+    void writeValue(const QJsonValue& value) {
+        switch (value.type()) {
+        case QJsonValue::Object:
+            writeObject(value.toObject());
+            break;
+        case QJsonValue::Array:
+            writeArray(value.toArray());
+            break;
+        case QJsonValue::String:
+            writeString(value.toString());
+            break;
+        case QJsonValue::Double:
+            writeNumber(value.toDouble());
+            break;
+        case QJsonValue::Bool:
+            write(value.toBool() ? "true" : "false");
+            break;
+        case QJsonValue::Null:
+        case QJsonValue::Undefined:
+            write("null");
+            break;
+        }
+    }
+
+    void writeObject(const QJsonObject& object) {
+        QStringList keys = object.keys();
+        std::sort(keys.begin(), keys.end(), [](const QString& a, const QString& b) {
+            int order = QString::compare(a, b, Qt::CaseInsensitive);
+            return order != 0 ? order < 0 : a < b;
+        });
+
+        put('{');
+        bool first = true;
+        for (const QString& key : keys) {
+            if (key == QLatin1String("originatorVersion")) {
+                continue;
+            }
+            if (!first) {
+                put(',');
+            }
+            first = false;
+            writeString(key);
+            put(':');
+            writeValue(object.value(key));
+        }
+        put('}');
+    }
+
+    void writeArray(const QJsonArray& array) {
+        put('[');
+        bool first = true;
+        for (const QJsonValue& item : array) {
+            if (!first) {
+                put(',');
+            }
+            first = false;
+            writeValue(item);
+        }
+        put(']');
+    }
+
+    void writeString(const QString& string) {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        put('"');
+        const QByteArray utf8 = string.toUtf8();
+        for (char c : utf8) {
+            switch (c) {
+            case '"':  write("\\\""); break;
+            case '\\': write("\\\\"); break;
+            case '\b': write("\\b"); break;
+            case '\f': write("\\f"); break;
+            case '\n': write("\\n"); break;
+            case '\r': write("\\r"); break;
+            case '\t': write("\\t"); break;
+            default:
+                if (uchar(c) < 0x20) {
+                    write("\\u00");
+                    put(hexDigits[uchar(c) >> 4]);
+                    put(hexDigits[uchar(c) & 0xf]);
+                } else {
+                    put(c);
+                }
+            }
+        }
+        put('"');
+    }
+
+    void writeNumber(double number) {
+        // Integral values are written without fraction or exponent
+        if (std::isfinite(number) && number == std::floor(number) && std::fabs(number) < 9007199254740992.0) {
+            write(QByteArray::number(qint64(number)));
+        } else {
+            write(QByteArray::number(number, 'g', QLocale::FloatingPointShortest));
+        }
+    }
+
+    QString finish() {
+        flush();
+        return QString::fromLatin1(m_sha.result().toHex());
+    }
+
+private:
+    void put(char c) {
+        if (m_size == sizeof(m_buffer)) {
+            flush();
+        }
+        m_buffer[m_size++] = c;
+    }
+
+    void write(const char* text) {
+        while (*text) {
+            put(*text++);
+        }
+    }
+
+    void write(const QByteArray& bytes) {
+        for (char c : bytes) {
+            put(c);
+        }
+    }
+
+    void flush() {
+        m_sha.addData(m_buffer, m_size);
+        m_size = 0;
+    }
+
+    Sha256 m_sha;
+    char m_buffer[4096];
+    qsizetype m_size = 0;
+};
+
+} // namespace
+
+QString ConfigKey::compute(const QJsonObject& settings) {
+    CanonicalJsonHasher hasher;
+    hasher.writeObject(settings);
+    return hasher.finish();
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,23 @@
+#ifndef SEB_CORE_CONFIG_KEY_H
+#define SEB_CORE_CONFIG_KEY_H
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+namespace seb {
+namespace core {
+
+// SEB Config Key: lowercase hex SHA-256 over the canonical JSON form of the
+// settings (object keys sorted case-insensitively, no whitespace,
+// "originatorVersion" omitted). The canonical form is streamed straight
+// into the hash and never materialized, so it is recomputed on every load
+// rather than cached where the key could be tampered with.
+class ConfigKey {
+public:
+    static QString compute(const QJsonObject& settings);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_CONFIG_KEY_H
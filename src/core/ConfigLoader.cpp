@@ -1,5 +1,12 @@
 #include "ConfigLoader.h"
+#include "ConfigKey.h"
+#include "PolicyBlob.h"
+#include "ResourceType.h"
+#include "SebFileReader.h"
+#include "UrlFilter.h"
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -10,32 +17,89 @@ namespace seb {
 namespace core {
 
 ConfigLoadResult ConfigLoader::loadFromFile(const QString& filePath) {
-    Policy policy;
+    QElapsedTimer timer;
+    timer.start();
 
-    // Open and read the file
+    // Open the file and map it instead of copying it into memory
     QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         return ConfigLoadResult(QString("Failed to open config file: %1").arg(filePath));
     }
 
-    QByteArray fileData = file.readAll();
-    file.close();
+    QByteArray fileData;
+    QByteArrayView data;
+    uchar* mapped = file.size() > 0 ? file.map(0, file.size()) : nullptr;
+    if (mapped) {
+        data = QByteArrayView(mapped, file.size());
+    } else {
+        // Not mappable (empty file, pipe, special file)
+        fileData = file.readAll();
+        data = fileData;
+    }
 
-    // Parse JSON
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(fileData, &parseError);
-    
-    if (parseError.error != QJsonParseError::NoError) {
-        return ConfigLoadResult(QString("JSON parse error at offset %1: %2")
-                                .arg(parseError.offset)
-                                .arg(parseError.errorString()));
+    if (PolicyBlob::isBlobData(data)) {
+        // Compiled by seb-policyc: config key and prebuilt tables included
+        QString error;
+        std::shared_ptr<const PolicyBlob> blob = PolicyBlob::open(filePath, &error);
+        if (!blob) {
+            return ConfigLoadResult(error);
+        }
+        // The checksum only detects damage; a hand-edited blob gets the same
+        // value checks as a JSON file
+        const QString validationError = validate(blob->policy());
+        if (!validationError.isEmpty()) {
+            return ConfigLoadResult(QString("Invalid compiled policy %1: %2").arg(filePath, validationError));
+        }
+        Policy policy = blob->policy();
+        policy.compiled = std::move(blob);
+        ConfigLoadResult result(policy);
+        result.parseTimeMs = timer.nsecsElapsed() / 1000000.0;
+        return result;
+    }
+
+    ConfigLoadResult result;
+    QJsonObject settings;
+    if (SebFileReader::isSebData(data)) {
+        // Native SEB configuration (.seb / plist)
+        SebFileResult sebResult = SebFileReader::read(data);
+        if (!sebResult.success) {
+            return ConfigLoadResult(sebResult.errorMessage);
+        }
+        settings = sebResult.settings;
+        result = loadFromJson(mapSebSettings(settings), QFileInfo(filePath).absoluteDir());
+    } else {
+        // Parse JSON
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(
+            QByteArray::fromRawData(data.data(), data.size()), &parseError);
+
+        if (parseError.error != QJsonParseError::NoError) {
+            return ConfigLoadResult(QString("JSON parse error at offset %1: %2")
+                                    .arg(parseError.offset)
+                                    .arg(parseError.errorString()));
+        }
+
+        if (!doc.isObject()) {
+            return ConfigLoadResult("Root JSON element is not an object");
+        }
+
+        settings = doc.object();
+        result = loadFromJson(settings, QFileInfo(filePath).absoluteDir());
     }
 
-    if (!doc.isObject()) {
-        return ConfigLoadResult("Root JSON element is not an object");
+    if (!result.success) {
+        return result;
     }
 
-    QJsonObject root = doc.object();
+    // Config key over exactly the settings that were parsed
+    result.policy.configKey = ConfigKey::compute(settings);
+
+    result.parseTimeMs = timer.nsecsElapsed() / 1000000.0;
+    return result;
+}
+
+ConfigLoadResult ConfigLoader::loadFromJson(const QJsonObject& root, const QDir& baseDir) {
+    Policy policy;
 
     // Load startUrl (required, must be valid HTTPS URL)
     if (!root.contains("startUrl")) {
@@ -46,22 +110,7 @@ ConfigLoadResult ConfigLoader::loadFromFile(const QString& filePath) {
         return ConfigLoadResult("Field 'startUrl' must be a string");
     }
     
-    QString urlString = root["startUrl"].toString();
-    if (urlString.isEmpty()) {
-        return ConfigLoadResult("Field 'startUrl' cannot be empty");
-    }
-    
-    QUrl url(urlString);
-    if (!url.isValid()) {
-        return ConfigLoadResult(QString("Invalid URL format: %1").arg(urlString));
-    }
-    
-    if (url.scheme() != "https") {
-        return ConfigLoadResult(QString("startUrl must use HTTPS scheme, got: %1")
-                                .arg(url.scheme()));
-    }
-    
-    policy.startUrl = urlString;
+    policy.startUrl = root["startUrl"].toString();
 
     // Load allowedDomains (optional array of strings)
     if (root.contains("allowedDomains")) {
@@ -108,9 +157,637 @@ ConfigLoadResult ConfigLoader::loadFromFile(const QString& filePath) {
         policy.sendConfigKey = root["sendConfigKey"].toBool();
     }
 
+    // Load browserExamKey (optional string)
+    if (root.contains("browserExamKey")) {
+        if (!root["browserExamKey"].isString()) {
+            return ConfigLoadResult("Field 'browserExamKey' must be a string");
+        }
+        policy.browserExamKey = root["browserExamKey"].toString();
+    }
+
+    // Load reloadOnChange (optional boolean, default false)
+    if (root.contains("reloadOnChange")) {
+        if (!root["reloadOnChange"].isBool()) {
+            return ConfigLoadResult("Field 'reloadOnChange' must be a boolean");
+        }
+        policy.reloadOnChange = root["reloadOnChange"].toBool();
+    }
+
+    // Load auditLogPath (optional string)
+    if (root.contains("auditLogPath")) {
+        if (!root["auditLogPath"].isString()) {
+            return ConfigLoadResult("Field 'auditLogPath' must be a string");
+        }
+        policy.auditLogPath = root["auditLogPath"].toString();
+    }
+
+    // Load blockedShortcuts (optional array of strings, replaces the defaults)
+    if (root.contains("blockedShortcuts")) {
+        if (!root["blockedShortcuts"].isArray()) {
+            return ConfigLoadResult("Field 'blockedShortcuts' must be an array");
+        }
+        policy.blockedShortcuts.clear();
+        for (const QJsonValue& value : root["blockedShortcuts"].toArray()) {
+            if (!value.isString()) {
+                return ConfigLoadResult("Field 'blockedShortcuts' must contain key combinations such as \"Ctrl+L\"");
+            }
+            policy.blockedShortcuts.append(value.toString());
+        }
+    }
+
+    // Load prefetch (optional object)
+    if (root.contains("prefetch")) {
+        if (!root["prefetch"].isObject()) {
+            return ConfigLoadResult("Field 'prefetch' must be an object");
+        }
+        QString error = loadPrefetch(root["prefetch"].toObject(), policy.prefetch);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load startLoad (optional object)
+    if (root.contains("startLoad")) {
+        if (!root["startLoad"].isObject()) {
+            return ConfigLoadResult("Field 'startLoad' must be an object");
+        }
+        QString error = loadStartLoad(root["startLoad"].toObject(), policy.startLoad);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load metrics (optional object)
+    if (root.contains("metrics")) {
+        if (!root["metrics"].isObject()) {
+            return ConfigLoadResult("Field 'metrics' must be an object");
+        }
+        QString error = loadMetrics(root["metrics"].toObject(), policy.metrics);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load resources (optional object)
+    if (root.contains("resources")) {
+        if (!root["resources"].isObject()) {
+            return ConfigLoadResult("Field 'resources' must be an object");
+        }
+        QString error = loadResources(root["resources"].toObject(), policy.resources);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load proxy (optional object)
+    if (root.contains("proxy")) {
+        if (!root["proxy"].isObject()) {
+            return ConfigLoadResult("Field 'proxy' must be an object");
+        }
+        QString error = loadProxy(root["proxy"].toObject(), policy.proxy);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load lockdown (optional object)
+    if (root.contains("lockdown")) {
+        if (!root["lockdown"].isObject()) {
+            return ConfigLoadResult("Field 'lockdown' must be an object");
+        }
+        QString error = loadLockdown(root["lockdown"].toObject(), policy.lockdown, baseDir);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    // Load urlFilterRules (optional array of rule objects)
+    if (root.contains("urlFilterRules")) {
+        if (!root["urlFilterRules"].isArray()) {
+            return ConfigLoadResult("Field 'urlFilterRules' must be an array");
+        }
+        QString error = loadUrlFilterRules(root["urlFilterRules"].toArray(), policy.urlFilterRules);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+        // Rules that compile alone can still clash once combined (same named group)
+        const UrlFilter urlFilter(policy.urlFilterRules);
+        if (!urlFilter.isValid()) {
+            return ConfigLoadResult(QString("Field 'urlFilterRules': %1").arg(urlFilter.errorString()));
+        }
+    }
+
+    // Load resourceRules (optional array of rule objects)
+    if (root.contains("resourceRules")) {
+        if (!root["resourceRules"].isArray()) {
+            return ConfigLoadResult("Field 'resourceRules' must be an array");
+        }
+        QString error = loadResourceRules(root["resourceRules"].toArray(), policy.resourceRules);
+        if (!error.isEmpty()) {
+            return ConfigLoadResult(error);
+        }
+    }
+
+    const QString error = validate(policy);
+    if (!error.isEmpty()) {
+        return ConfigLoadResult(error);
+    }
+
     return ConfigLoadResult(policy);
 }
 
+QString ConfigLoader::validate(const Policy& policy) {
+    const QUrl startUrl(policy.startUrl);
+    if (policy.startUrl.isEmpty()) {
+        return "Field 'startUrl' cannot be empty";
+    }
+    if (!startUrl.isValid()) {
+        return QString("Invalid URL format: %1").arg(policy.startUrl);
+    }
+    if (startUrl.scheme() != "https") {
+        return QString("startUrl must use HTTPS scheme, got: %1").arg(startUrl.scheme());
+    }
+
+    const PrefetchSettings& prefetch = policy.prefetch;
+    for (const QString& value : prefetch.urls) {
+        const QUrl url(value);
+        if (!url.isValid() || url.scheme() != "https") {
+            return QString("Field 'prefetch.urls' must contain HTTPS URLs, got: %1").arg(value);
+        }
+    }
+    if (!prefetch.manifestUrl.isEmpty()) {
+        const QUrl url(prefetch.manifestUrl);
+        if (!url.isValid() || url.scheme() != "https") {
+            return "Field 'prefetch.manifestUrl' must be an HTTPS URL";
+        }
+    }
+    if (prefetch.concurrency < 1 || prefetch.concurrency > 16) {
+        return "Field 'prefetch.concurrency' must be an integer between 1 and 16";
+    }
+    if (prefetch.jitterMs < 0 || prefetch.jitterMs > 3600000) {
+        return "Field 'prefetch.jitterMs' must be an integer between 0 and 3600000";
+    }
+
+    const StartLoadSettings& startLoad = policy.startLoad;
+    const struct {
+        const char* name;
+        int value;
+    } startLoadFields[] = {
+        {"spreadMs", startLoad.spreadMs},
+        {"maxRetries", startLoad.maxRetries},
+        {"initialBackoffMs", startLoad.initialBackoffMs},
+        {"maxBackoffMs", startLoad.maxBackoffMs},
+    };
+    for (const auto& field : startLoadFields) {
+        if (field.value < 0) {
+            return QString("Field 'startLoad.%1' must be a non-negative integer").arg(field.name);
+        }
+    }
+    if (startLoad.maxBackoffMs < startLoad.initialBackoffMs) {
+        return "Field 'startLoad.maxBackoffMs' must not be smaller than 'startLoad.initialBackoffMs'";
+    }
+
+    if (policy.metrics.intervalMs < 1000) {
+        return "Field 'metrics.intervalMs' must be an integer of at least 1000";
+    }
+
+    // single-process is not offered: it turns off the renderer sandbox
+    const ResourceSettings& resources = policy.resources;
+    if (!resources.processModel.isEmpty() && resources.processModel != "process-per-site-instance"
+        && resources.processModel != "process-per-site") {
+        return "Field 'resources.processModel' must be \"process-per-site-instance\" or \"process-per-site\"";
+    }
+    const struct {
+        const char* name;
+        int value;
+    } resourceFields[] = {
+        {"rendererProcessLimit", resources.rendererProcessLimit},
+        {"jsHeapLimitMb", resources.jsHeapLimitMb},
+        {"httpCacheMb", resources.httpCacheMb},
+        {"memoryReportIntervalMs", resources.memoryReportIntervalMs},
+    };
+    for (const auto& field : resourceFields) {
+        if (field.value < 0) {
+            return QString("Field 'resources.%1' must be a non-negative integer").arg(field.name);
+        }
+    }
+    if (resources.httpCacheMb > 2047) {
+        return "Field 'resources.httpCacheMb' must not exceed 2047";
+    }
+    if (resources.jsHeapLimitMb > 0 && resources.jsHeapLimitMb < 64) {
+        return "Field 'resources.jsHeapLimitMb' must be 0 or at least 64";
+    }
+    for (const QString& feature : resources.disabledFeatures) {
+        if (feature.isEmpty() || feature.contains(',') || feature.contains(' ')) {
+            return QString("Field 'resources.disabledFeatures' must contain feature names, got: %1").arg(feature);
+        }
+    }
+
+    const QString error = validateProxy(policy.proxy);
+    if (!error.isEmpty()) {
+        return error;
+    }
+
+    const QList<UserScript>& scripts = policy.lockdown.userScripts;
+    for (qsizetype i = 0; i < scripts.size(); ++i) {
+        if (scripts[i].path.isEmpty() || !QFileInfo(scripts[i].path).isReadable()) {
+            return QString("Field 'lockdown.userScripts[%1].path' must name a readable file").arg(i);
+        }
+    }
+
+    for (qsizetype i = 0; i < policy.resourceRules.size(); ++i) {
+        const ResourceRule& rule = policy.resourceRules[i];
+        if (rule.types.isEmpty()) {
+            return QString("Field 'resourceRules[%1].types' must be a non-empty array").arg(i);
+        }
+        for (const QString& type : rule.types) {
+            const int slot = ResourceType::slotFromName(type);
+            if (slot < 0) {
+                return QString("Field 'resourceRules[%1].types': unknown resource type '%2'").arg(i).arg(type);
+            }
+            // Top-level navigations are governed by the allowlist and URL filter
+            if (slot == ResourceType::MainFrame) {
+                return QString("Field 'resourceRules[%1].types': main_frame cannot be restricted").arg(i);
+            }
+        }
+        for (const QString& domain : rule.domains) {
+            if (domain.isEmpty()) {
+                return QString("Field 'resourceRules[%1].domains' must contain host names").arg(i);
+            }
+        }
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::validateProxy(const ProxySettings& proxy) {
+    if (proxy.mode != "system" && proxy.mode != "direct" && proxy.mode != "fixed" && proxy.mode != "pac") {
+        return "Field 'proxy.mode' must be \"system\", \"direct\", \"fixed\" or \"pac\"";
+    }
+
+    if (proxy.mode == "fixed") {
+        const QUrl url(proxy.server);
+        static const QStringList schemes = {"http", "https", "socks4", "socks5"};
+        if (!url.isValid() || url.host().isEmpty() || url.port() <= 0 || !schemes.contains(url.scheme())
+            || (!url.path().isEmpty() && url.path() != "/") || !url.userInfo().isEmpty()) {
+            return "Field 'proxy.server' must be [scheme://]host:port with scheme http, https, socks4 or socks5";
+        }
+    } else if (!proxy.server.isEmpty()) {
+        return "Field 'proxy.server' requires mode \"fixed\"";
+    }
+
+    if (proxy.mode == "pac") {
+        const QUrl url(proxy.pacUrl);
+        static const QStringList schemes = {"http", "https", "file", "data"};
+        if (!url.isValid() || !schemes.contains(url.scheme())) {
+            return "Field 'proxy.pacUrl' must be an http, https, file or data URL";
+        }
+    } else if (!proxy.pacUrl.isEmpty()) {
+        return "Field 'proxy.pacUrl' requires mode \"pac\"";
+    }
+
+    // A PAC script decides on its own which hosts go direct
+    if (!proxy.bypass.isEmpty() && proxy.mode != "fixed") {
+        return "Field 'proxy.bypass' requires mode \"fixed\"";
+    }
+    for (const QString& host : proxy.bypass) {
+        if (host.isEmpty() || host.contains(' ') || host.contains(';') || host.contains(',')) {
+            return QString("Field 'proxy.bypass' must contain host names, got: %1").arg(host);
+        }
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadPrefetch(const QJsonObject& section, PrefetchSettings& prefetch) {
+    if (section.contains("urls")) {
+        if (!section["urls"].isArray()) {
+            return "Field 'prefetch.urls' must be an array";
+        }
+        for (const QJsonValue& value : section["urls"].toArray()) {
+            if (!value.isString()) {
+                return "Field 'prefetch.urls' must contain HTTPS URLs";
+            }
+            prefetch.urls.append(value.toString());
+        }
+    }
+
+    if (section.contains("manifestUrl")) {
+        if (!section["manifestUrl"].isString() || section["manifestUrl"].toString().isEmpty()) {
+            return "Field 'prefetch.manifestUrl' must be an HTTPS URL";
+        }
+        prefetch.manifestUrl = section["manifestUrl"].toString();
+    }
+
+    // Non-integers read as -1, which validate() rejects
+    if (section.contains("concurrency")) {
+        prefetch.concurrency = section["concurrency"].toInt(-1);
+    }
+    if (section.contains("jitterMs")) {
+        prefetch.jitterMs = section["jitterMs"].toInt(-1);
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadStartLoad(const QJsonObject& section, StartLoadSettings& startLoad) {
+    const struct {
+        const char* name;
+        int* target;
+    } fields[] = {
+        {"spreadMs", &startLoad.spreadMs},
+        {"maxRetries", &startLoad.maxRetries},
+        {"initialBackoffMs", &startLoad.initialBackoffMs},
+        {"maxBackoffMs", &startLoad.maxBackoffMs},
+    };
+
+    // Non-integers read as -1, which validate() rejects
+    for (const auto& field : fields) {
+        if (section.contains(field.name)) {
+            *field.target = section[field.name].toInt(-1);
+        }
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadMetrics(const QJsonObject& section, MetricsSettings& metrics) {
+    for (const char* name : {"textfilePath", "socketPath"}) {
+        if (section.contains(name) && !section[name].isString()) {
+            return QString("Field 'metrics.%1' must be a string").arg(name);
+        }
+    }
+    metrics.textfilePath = section["textfilePath"].toString();
+    metrics.socketPath = section["socketPath"].toString();
+
+    if (section.contains("intervalMs")) {
+        metrics.intervalMs = section["intervalMs"].toInt(-1);
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadResources(const QJsonObject& section, ResourceSettings& resources) {
+    if (section.contains("profile")) {
+        const QString profile = section["profile"].toString();
+        if (profile == "lowMemory") {
+            resources = ResourceSettings::lowMemory();
+        } else if (profile != "default") {
+            return "Field 'resources.profile' must be \"default\" or \"lowMemory\"";
+        }
+    }
+
+    if (section.contains("processModel")) {
+        if (!section["processModel"].isString() || section["processModel"].toString().isEmpty()) {
+            return "Field 'resources.processModel' must be \"process-per-site-instance\" or \"process-per-site\"";
+        }
+        resources.processModel = section["processModel"].toString();
+    }
+
+    const struct {
+        const char* name;
+        int* target;
+    } fields[] = {
+        {"rendererProcessLimit", &resources.rendererProcessLimit},
+        {"jsHeapLimitMb", &resources.jsHeapLimitMb},
+        {"httpCacheMb", &resources.httpCacheMb},
+        {"memoryReportIntervalMs", &resources.memoryReportIntervalMs},
+    };
+
+    // Non-integers read as -1, which validate() rejects
+    for (const auto& field : fields) {
+        if (section.contains(field.name)) {
+            *field.target = section[field.name].toInt(-1);
+        }
+    }
+
+    if (section.contains("disabledFeatures")) {
+        if (!section["disabledFeatures"].isArray()) {
+            return "Field 'resources.disabledFeatures' must be an array";
+        }
+        resources.disabledFeatures.clear();
+        for (const QJsonValue& value : section["disabledFeatures"].toArray()) {
+            if (!value.isString()) {
+                return "Field 'resources.disabledFeatures' must contain feature names";
+            }
+            resources.disabledFeatures.append(value.toString());
+        }
+    }
+
+    if (section.contains("disableBackgroundNetworking")) {
+        if (!section["disableBackgroundNetworking"].isBool()) {
+            return "Field 'resources.disableBackgroundNetworking' must be a boolean";
+        }
+        resources.disableBackgroundNetworking = section["disableBackgroundNetworking"].toBool();
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadProxy(const QJsonObject& section, ProxySettings& proxy) {
+    for (const char* name : {"mode", "server", "pacUrl"}) {
+        if (section.contains(name) && !section[name].isString()) {
+            return QString("Field 'proxy.%1' must be a string").arg(name);
+        }
+    }
+    proxy.mode = section["mode"].toString("system");
+
+    if (section.contains("server")) {
+        // host:port defaults to an HTTP proxy
+        QString server = section["server"].toString();
+        if (!server.contains("://")) {
+            server.prepend("http://");
+        }
+        proxy.server = QUrl(server).toString(QUrl::StripTrailingSlash);
+        if (proxy.server.isEmpty()) {
+            return "Field 'proxy.server' must be [scheme://]host:port with scheme http, https, socks4 or socks5";
+        }
+    }
+
+    if (section.contains("pacUrl")) {
+        proxy.pacUrl = QString::fromLatin1(QUrl(section["pacUrl"].toString()).toEncoded());
+        if (proxy.pacUrl.isEmpty()) {
+            return "Field 'proxy.pacUrl' must be an http, https, file or data URL";
+        }
+    }
+
+    if (section.contains("bypass")) {
+        if (!section["bypass"].isArray()) {
+            return "Field 'proxy.bypass' must be an array";
+        }
+        for (const QJsonValue& value : section["bypass"].toArray()) {
+            if (!value.isString()) {
+                return "Field 'proxy.bypass' must contain host names";
+            }
+            proxy.bypass.append(value.toString().trimmed().toLower());
+        }
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadLockdown(const QJsonObject& section, LockdownSettings& lockdown, const QDir& baseDir) {
+    const struct {
+        const char* name;
+        bool* target;
+    } flags[] = {
+        {"blockContextMenu", &lockdown.blockContextMenu},
+        {"blockTextSelection", &lockdown.blockTextSelection},
+        {"blockClipboard", &lockdown.blockClipboard},
+    };
+
+    for (const auto& flag : flags) {
+        if (!section.contains(flag.name)) {
+            continue;
+        }
+        if (!section[flag.name].isBool()) {
+            return QString("Field 'lockdown.%1' must be a boolean").arg(flag.name);
+        }
+        *flag.target = section[flag.name].toBool();
+    }
+
+    if (section.contains("userScripts")) {
+        if (!section["userScripts"].isArray()) {
+            return "Field 'lockdown.userScripts' must be an array";
+        }
+        const QJsonArray scripts = section["userScripts"].toArray();
+        for (qsizetype i = 0; i < scripts.size(); ++i) {
+            const QJsonObject object = scripts[i].toObject();
+            if (!object["path"].isString() || object["path"].toString().isEmpty()) {
+                return QString("Field 'lockdown.userScripts[%1].path' must name a readable file").arg(i);
+            }
+
+            // Relative to the config file, not to wherever seb-linux was started
+            UserScript script;
+            script.path = baseDir.absoluteFilePath(object["path"].toString());
+
+            const QString world = object["world"].toString("isolated");
+            if (world != "isolated" && world != "main") {
+                return QString("Field 'lockdown.userScripts[%1].world' must be \"isolated\" or \"main\"").arg(i);
+            }
+            script.mainWorld = world == "main";
+
+            const QString injectionPoint = object["injectionPoint"].toString("documentCreation");
+            if (injectionPoint != "documentCreation" && injectionPoint != "documentReady") {
+                return QString("Field 'lockdown.userScripts[%1].injectionPoint' must be \"documentCreation\" or \"documentReady\"").arg(i);
+            }
+            script.atDocumentReady = injectionPoint == "documentReady";
+
+            lockdown.userScripts.append(script);
+        }
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadUrlFilterRules(const QJsonArray& rules, QList<UrlFilterRule>& urlFilterRules) {
+    for (qsizetype i = 0; i < rules.size(); ++i) {
+        if (!rules[i].isObject()) {
+            return QString("Field 'urlFilterRules[%1]' must be an object").arg(i);
+        }
+        const QJsonObject object = rules[i].toObject();
+
+        UrlFilterRule rule;
+        if (!object["expression"].isString()) {
+            return QString("Field 'urlFilterRules[%1].expression' must be a string").arg(i);
+        }
+        rule.expression = object["expression"].toString();
+        rule.regex = object["regex"].toBool(false);
+        rule.active = object["active"].toBool(true);
+
+        // "allow"/"block", or SEB's numeric 1/0
+        const QJsonValue action = object["action"];
+        const QString actionName = action.isDouble() ? QString::number(action.toDouble()) : action.toString();
+        if (actionName == "allow" || actionName == "1") {
+            rule.action = UrlFilterRule::Action::Allow;
+        } else if (actionName == "block" || actionName == "0") {
+            rule.action = UrlFilterRule::Action::Block;
+        } else {
+            return QString("Field 'urlFilterRules[%1].action' must be \"allow\" or \"block\"").arg(i);
+        }
+
+        if (rule.active) {
+            QString error;
+            if (UrlFilter::ruleToPattern(rule, &error).isEmpty()) {
+                return QString("Field 'urlFilterRules[%1]': %2").arg(i).arg(error);
+            }
+        }
+        urlFilterRules.append(rule);
+    }
+
+    return QString();
+}
+
+QString ConfigLoader::loadResourceRules(const QJsonArray& rules, QList<ResourceRule>& resourceRules) {
+    for (qsizetype i = 0; i < rules.size(); ++i) {
+        if (!rules[i].isObject()) {
+            return QString("Field 'resourceRules[%1]' must be an object").arg(i);
+        }
+        const QJsonObject object = rules[i].toObject();
+
+        ResourceRule rule;
+        if (!object["types"].isArray() || object["types"].toArray().isEmpty()) {
+            return QString("Field 'resourceRules[%1].types' must be a non-empty array").arg(i);
+        }
+        for (const QJsonValue& value : object["types"].toArray()) {
+            rule.types.append(value.toString());
+        }
+
+        if (object.contains("domains")) {
+            if (!object["domains"].isArray()) {
+                return QString("Field 'resourceRules[%1].domains' must be an array").arg(i);
+            }
+            for (const QJsonValue& value : object["domains"].toArray()) {
+                if (!value.isString()) {
+                    return QString("Field 'resourceRules[%1].domains' must contain host names").arg(i);
+                }
+                rule.domains.append(value.toString().toLower());
+            }
+        }
+        rule.thirdPartyOnly = object["thirdParty"].toBool(false);
+
+        const QString action = object["action"].toString("block");
+        if (action == "allow") {
+            rule.action = ResourceRule::Action::Allow;
+        } else if (action == "block") {
+            rule.action = ResourceRule::Action::Block;
+        } else {
+            return QString("Field 'resourceRules[%1].action' must be \"allow\" or \"block\"").arg(i);
+        }
+        resourceRules.append(rule);
+    }
+
+    return QString();
+}
+
+QJsonObject ConfigLoader::mapSebSettings(const QJsonObject& sebSettings) {
+    // seb-linux specific keys may be embedded in the .seb file as well
+    QJsonObject root = sebSettings;
+
+    if (sebSettings.contains("startURL")) {
+        root["startUrl"] = sebSettings["startURL"];
+    }
+    if (sebSettings.contains("sendBrowserExamKey")) {
+        root["sendConfigKey"] = sebSettings["sendBrowserExamKey"];
+    }
+
+    // SEB URL filter rules only apply while the filter is enabled
+    if (sebSettings.contains("URLFilterRules") && !root.contains("urlFilterRules")
+        && sebSettings["URLFilterEnable"].toBool(false)) {
+        root["urlFilterRules"] = sebSettings["URLFilterRules"];
+    }
+
+    // Without an explicit allowlist, allow the start URL's domain
+    if (!root.contains("allowedDomains") && root["startUrl"].isString()) {
+        QString host = QUrl(root["startUrl"].toString()).host();
+        if (!host.isEmpty()) {
+            root["allowedDomains"] = QJsonArray{host};
+        }
+    }
+
+    return root;
+}
+
 Policy ConfigLoader::loadFromFileLegacy(const QString& filePath) {
     ConfigLoadResult result = loadFromFile(filePath);
     return result.policy;
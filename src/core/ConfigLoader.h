@@ -2,6 +2,9 @@
 #define SEB_CORE_CONFIG_LOADER_H
 
 #include "Config.h"
+#include <QtCore/QDir>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QString>
 
 namespace seb {
@@ -11,6 +14,7 @@ struct ConfigLoadResult {
     Policy policy;
     bool success;
     QString errorMessage;
+    double parseTimeMs = 0.0;      // Time spent reading and parsing the file
     
     ConfigLoadResult() : success(false) {}
     ConfigLoadResult(const Policy& p) : policy(p), success(true) {}
@@ -19,12 +23,37 @@ struct ConfigLoadResult {
 
 class ConfigLoader {
 public:
-    // Load policy from a JSON file
+    // Load policy from a JSON file, a native SEB file (.seb / plist) or a
+    // policy compiled by seb-policyc
     // Returns ConfigLoadResult with success status and error message
     static ConfigLoadResult loadFromFile(const QString& filePath);
     
     // Legacy method for backward compatibility
     static Policy loadFromFileLegacy(const QString& filePath);
+
+    // Range and consistency checks on a parsed policy, shared by every
+    // input format; return an error message or empty
+    static QString validate(const Policy& policy);
+
+private:
+    // Validate a settings object in the seb-linux JSON schema; relative file
+    // paths in it are resolved against baseDir (the config file's directory)
+    static ConfigLoadResult loadFromJson(const QJsonObject& root, const QDir& baseDir);
+
+    // Parse an optional settings section into its fields; values are
+    // range-checked afterwards by validate(). Return an error message or empty
+    static QString loadPrefetch(const QJsonObject& section, PrefetchSettings& prefetch);
+    static QString loadStartLoad(const QJsonObject& section, StartLoadSettings& startLoad);
+    static QString loadMetrics(const QJsonObject& section, MetricsSettings& metrics);
+    static QString loadResources(const QJsonObject& section, ResourceSettings& resources);
+    static QString loadProxy(const QJsonObject& section, ProxySettings& proxy);
+    static QString validateProxy(const ProxySettings& proxy);
+    static QString loadLockdown(const QJsonObject& section, LockdownSettings& lockdown, const QDir& baseDir);
+    static QString loadUrlFilterRules(const QJsonArray& rules, QList<UrlFilterRule>& urlFilterRules);
+    static QString loadResourceRules(const QJsonArray& rules, QList<ResourceRule>& resourceRules);
+
+    // Map SEB setting names (startURL, ...) onto the JSON schema
+    static QJsonObject mapSebSettings(const QJsonObject& sebSettings);
 };
 
 } // namespace core
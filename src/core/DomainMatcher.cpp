@@ -0,0 +1,213 @@
+#include "DomainMatcher.h"
+#include "Logging.h"
+#include <QtCore/QUrl>
+#include <QtCore/QDebug>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace seb {
+namespace core {
+
+DomainMatcher::DomainMatcher(const QStringList& domains) {
+    // Build an intermediate tree first, then flatten it breadth-first so the
+    // children of every node end up in one sorted, contiguous edge range
+    struct BuildNode {
+        std::map<QString, int> children;
+        bool terminal = false;
+    };
+    std::vector<BuildNode> tree(1);
+
+    for (const QString& domain : domains) {
+        QString normalized = normalize(domain);
+        if (normalized.isEmpty()) {
+            qCWarning(lcConfig) << "Ignoring invalid allowed domain:" << domain;
+            continue;
+        }
+
+        const QStringList labels = normalized.split('.');
+        int node = 0;
+        for (auto it = labels.crbegin(); it != labels.crend(); ++it) {
+            auto child = tree[node].children.find(*it);
+            if (child == tree[node].children.end()) {
+                tree.emplace_back();
+                child = tree[node].children.emplace(*it, int(tree.size() - 1)).first;
+            }
+            node = child->second;
+        }
+        tree[node].terminal = true;
+    }
+
+    // Order nodes breadth-first; children of terminal nodes are redundant
+    // because the terminal node already matches its whole subtree
+    std::vector<int> order{0};
+    std::vector<int> flatIndex(tree.size(), -1);
+    flatIndex[0] = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const BuildNode& node = tree[order[i]];
+        if (node.terminal) {
+            continue;
+        }
+        for (const auto& child : node.children) {
+            flatIndex[child.second] = int(order.size());
+            order.push_back(child.second);
+        }
+    }
+
+    struct Storage {
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+        QString labels;
+    };
+    auto storage = std::make_shared<Storage>();
+    storage->nodes.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const BuildNode& node = tree[order[i]];
+        Node& flat = storage->nodes[i];
+        flat.terminal = node.terminal ? 1 : 0;
+        flat.firstEdge = quint32(storage->edges.size());
+        if (!node.terminal) {
+            for (const auto& child : node.children) {
+                storage->edges.push_back(Edge{quint32(storage->labels.size()), quint32(child.first.size()),
+                                              quint32(flatIndex[child.second])});
+                storage->labels += child.first;
+            }
+        }
+        flat.edgeCount = quint32(storage->edges.size()) - flat.firstEdge;
+    }
+
+    m_nodes = storage->nodes.data();
+    m_nodeCount = qsizetype(storage->nodes.size());
+    m_edges = storage->edges.data();
+    m_edgeCount = qsizetype(storage->edges.size());
+    m_labels = reinterpret_cast<const char16_t*>(storage->labels.utf16());
+    m_labelCount = storage->labels.size();
+    m_storage = std::move(storage);
+}
+
+DomainMatcher DomainMatcher::fromTables(const Tables& tables, std::shared_ptr<const void> storage,
+                                        QString* errorString) {
+    auto fail = [errorString](const char* message) {
+        if (errorString) {
+            *errorString = QString::fromLatin1(message);
+        }
+        return DomainMatcher();
+    };
+
+    if (tables.nodes.size() % qsizetype(sizeof(Node)) != 0
+        || tables.edges.size() % qsizetype(sizeof(Edge)) != 0
+        || tables.labels.size() % qsizetype(sizeof(char16_t)) != 0) {
+        return fail("Domain table sizes are not a multiple of their entry size");
+    }
+    if (quintptr(tables.nodes.data()) % alignof(Node) != 0
+        || quintptr(tables.edges.data()) % alignof(Edge) != 0
+        || quintptr(tables.labels.data()) % alignof(char16_t) != 0) {
+        return fail("Domain tables are misaligned");
+    }
+
+    DomainMatcher matcher;
+    matcher.m_nodes = reinterpret_cast<const Node*>(tables.nodes.data());
+    matcher.m_nodeCount = tables.nodes.size() / qsizetype(sizeof(Node));
+    matcher.m_edges = reinterpret_cast<const Edge*>(tables.edges.data());
+    matcher.m_edgeCount = tables.edges.size() / qsizetype(sizeof(Edge));
+    matcher.m_labels = reinterpret_cast<const char16_t*>(tables.labels.data());
+    matcher.m_labelCount = tables.labels.size() / qsizetype(sizeof(char16_t));
+
+    // Lookups index without checks; validate every reference once here
+    for (qsizetype i = 0; i < matcher.m_nodeCount; ++i) {
+        const Node& node = matcher.m_nodes[i];
+        if (quint64(node.firstEdge) + node.edgeCount > quint64(matcher.m_edgeCount)) {
+            return fail("Domain node references edges out of range");
+        }
+    }
+    for (qsizetype i = 0; i < matcher.m_edgeCount; ++i) {
+        const Edge& edge = matcher.m_edges[i];
+        if (edge.child >= quint64(matcher.m_nodeCount)
+            || quint64(edge.labelOffset) + edge.labelLength > quint64(matcher.m_labelCount)) {
+            return fail("Domain edge references data out of range");
+        }
+    }
+
+    matcher.m_storage = std::move(storage);
+    return matcher;
+}
+
+DomainMatcher::Tables DomainMatcher::tables() const {
+    return Tables{
+        QByteArrayView(reinterpret_cast<const char*>(m_nodes), m_nodeCount * qsizetype(sizeof(Node))),
+        QByteArrayView(reinterpret_cast<const char*>(m_edges), m_edgeCount * qsizetype(sizeof(Edge))),
+        QByteArrayView(reinterpret_cast<const char*>(m_labels), m_labelCount * qsizetype(sizeof(char16_t)))
+    };
+}
+
+QStringView DomainMatcher::matchedDomain(QStringView host) const {
+    if (host.endsWith(u'.')) {
+        host.chop(1);
+    }
+    if (host.isEmpty() || m_nodeCount == 0) {
+        return QStringView();
+    }
+
+    // Walk labels right to left; reaching a terminal node means the host is
+    // the allowed domain itself or one of its subdomains
+    int node = 0;
+    qsizetype end = host.size();
+    while (end > 0) {
+        qsizetype dot = host.lastIndexOf(u'.', end - 1);
+        node = findChild(node, host.mid(dot + 1, end - dot - 1));
+        if (node < 0) {
+            return QStringView();
+        }
+        if (m_nodes[node].terminal) {
+            return host.mid(dot + 1);
+        }
+        if (dot < 0) {
+            break;
+        }
+        end = dot;
+    }
+
+    return QStringView();
+}
+
+int DomainMatcher::findChild(int node, QStringView label) const {
+    if (label.isEmpty()) {
+        return -1;
+    }
+
+    const Node& parent = m_nodes[node];
+    const Edge* begin = m_edges + parent.firstEdge;
+    const Edge* end = begin + parent.edgeCount;
+    const Edge* it = std::lower_bound(begin, end, label, [this](const Edge& edge, QStringView key) {
+        return this->label(edge).compare(key, Qt::CaseInsensitive) < 0;
+    });
+    if (it == end || this->label(*it).compare(label, Qt::CaseInsensitive) != 0) {
+        return -1;
+    }
+    return int(it->child);
+}
+
+QString DomainMatcher::normalize(const QString& domain) {
+    QString host = domain.trimmed();
+    if (host.startsWith("*.")) {
+        host.remove(0, 2);
+    }
+    while (host.startsWith('.')) {
+        host.remove(0, 1);
+    }
+    while (host.endsWith('.')) {
+        host.chop(1);
+    }
+    if (host.isEmpty()) {
+        return QString();
+    }
+
+    QByteArray ace = QUrl::toAce(host);
+    if (ace.isEmpty()) {
+        return QString();
+    }
+    return QString::fromLatin1(ace).toLower();
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,93 @@
+#ifndef SEB_CORE_DOMAIN_MATCHER_H
+#define SEB_CORE_DOMAIN_MATCHER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QStringView>
+#include <QtCore/QtGlobal>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+// Compiled allowlist of domains, stored as a trie over reversed host labels
+// ("cdn.example.com" -> com -> example -> cdn).
+//
+// A host matches when it equals an allowed domain or is a subdomain of one
+// (e.g., "cdn.example.com" matches "example.com"). Domains are case-folded and
+// converted to their ASCII (punycode) form once at build time; lookups walk
+// the host labels right to left using string views and never allocate.
+//
+// The trie lives in three flat tables (nodes, edges, UTF-16 label pool) in
+// the layout PolicyBlob stores, so a precompiled matcher is used directly
+// from the mapped file without copying.
+class DomainMatcher {
+public:
+    struct Node {
+        quint32 firstEdge;
+        quint32 edgeCount;
+        quint32 terminal;
+    };
+
+    struct Edge {
+        quint32 labelOffset;       // In UTF-16 code units into the label pool
+        quint32 labelLength;
+        quint32 child;
+    };
+
+    struct Tables {
+        QByteArrayView nodes;
+        QByteArrayView edges;
+        QByteArrayView labels;
+    };
+
+    DomainMatcher() = default;
+    explicit DomainMatcher(const QStringList& domains);
+
+    // Use serialized tables in place; storage keeps their memory alive.
+    // Returns an empty matcher and sets errorString if the tables are
+    // inconsistent.
+    static DomainMatcher fromTables(const Tables& tables, std::shared_ptr<const void> storage,
+                                    QString* errorString = nullptr);
+
+    Tables tables() const;
+
+    // Host is expected in ASCII form, e.g. QUrl::host(QUrl::FullyEncoded)
+    bool matches(QStringView host) const { return !matchedDomain(host).isEmpty(); }
+
+    // The broadest allowed domain `host` falls under, as a view into `host`
+    // ("example.co.uk" for "www.example.co.uk"); empty if it matches none
+    QStringView matchedDomain(QStringView host) const;
+
+    bool isEmpty() const { return m_nodeCount <= 1; }
+
+    // Normalize a configured domain: trim, strip leading "*." / ".",
+    // strip trailing ".", convert to punycode and lowercase.
+    // Returns an empty string if the domain is not a valid host name.
+    static QString normalize(const QString& domain);
+
+private:
+    int findChild(int node, QStringView label) const;
+
+    QStringView label(const Edge& edge) const {
+        return QStringView(m_labels + edge.labelOffset, qsizetype(edge.labelLength));
+    }
+
+    // Owner of the table memory (built tables or the mapped policy blob)
+    std::shared_ptr<const void> m_storage;
+
+    // Node 0 is the root; edges of a node are contiguous and sorted by label
+    const Node* m_nodes = nullptr;
+    qsizetype m_nodeCount = 0;
+    const Edge* m_edges = nullptr;
+    qsizetype m_edgeCount = 0;
+    const char16_t* m_labels = nullptr;
+    qsizetype m_labelCount = 0;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_DOMAIN_MATCHER_H
@@ -0,0 +1,70 @@
+#include "HostVerdictCache.h"
+#include <QtCore/QHashFunctions>
+#include <QtCore/QRandomGenerator>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+// Entry layout: bit 63 marks an occupied slot, bit 0 holds the verdict
+// (1 = allowed) and the remaining bits hold the host hash
+constexpr quint64 OccupiedBit = quint64(1) << 63;
+constexpr quint64 AllowedBit = 1;
+
+constexpr int MinCapacity = 64;
+constexpr int MaxCapacity = 4096;
+
+} // namespace
+
+HostVerdictCache::HostVerdictCache(int capacity)
+    : m_mask(0)
+    , m_seed(size_t(QRandomGenerator::system()->generate64()))
+    , m_hits(0)
+    , m_misses(0)
+{
+    int size = MinCapacity;
+    while (size < capacity && size < MaxCapacity) {
+        size *= 2;
+    }
+    m_mask = quint64(size - 1);
+    m_slots.reset(new std::atomic<quint64>[size]);
+    clear();
+}
+
+int HostVerdictCache::capacityForDomainCount(int domainCount) {
+    // Pages typically touch a few hosts per allowed domain (CDNs, APIs)
+    // plus some blocked third parties
+    return qBound(MinCapacity, domainCount * 8, MaxCapacity);
+}
+
+HostVerdictCache::Verdict HostVerdictCache::lookup(QStringView host) const {
+    const quint64 tag = tagFor(host);
+    const quint64 entry = m_slots[(tag >> 1) & m_mask].load(std::memory_order_acquire);
+
+    if ((entry & ~AllowedBit) != tag) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::Unknown;
+    }
+
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return (entry & AllowedBit) ? Verdict::Allowed : Verdict::Blocked;
+}
+
+void HostVerdictCache::store(QStringView host, bool allowed) {
+    const quint64 tag = tagFor(host);
+    m_slots[(tag >> 1) & m_mask].store(tag | (allowed ? AllowedBit : 0), std::memory_order_release);
+}
+
+void HostVerdictCache::clear() {
+    for (quint64 i = 0; i <= m_mask; ++i) {
+        m_slots[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+quint64 HostVerdictCache::tagFor(QStringView host) const {
+    return (quint64(qHash(host, m_seed)) | OccupiedBit) & ~AllowedBit;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,53 @@
+#ifndef SEB_CORE_HOST_VERDICT_CACHE_H
+#define SEB_CORE_HOST_VERDICT_CACHE_H
+
+#include <QtCore/QStringView>
+#include <QtCore/QtGlobal>
+#include <atomic>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+// Bounded host -> allow/block verdict cache for the request hot path.
+//
+// Direct-mapped table of atomic 64-bit entries, each packing a keyed hash of
+// the host with the verdict bit. Lookups are a single atomic load and never
+// lock or allocate; stores simply overwrite the slot. The hash seed is
+// random per process, so a page cannot craft a host that aliases a cached
+// allowed host.
+class HostVerdictCache {
+public:
+    enum class Verdict {
+        Unknown,
+        Allowed,
+        Blocked
+    };
+
+    explicit HostVerdictCache(int capacity);
+
+    // Capacity to use for a policy with the given number of allowed domains
+    static int capacityForDomainCount(int domainCount);
+
+    Verdict lookup(QStringView host) const;
+    void store(QStringView host, bool allowed);
+    void clear();
+
+    int capacity() const { return int(m_mask + 1); }
+    quint64 hits() const { return m_hits.load(std::memory_order_relaxed); }
+    quint64 misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    quint64 tagFor(QStringView host) const;
+
+    std::unique_ptr<std::atomic<quint64>[]> m_slots;
+    quint64 m_mask;
+    size_t m_seed;
+    mutable std::atomic<quint64> m_hits;
+    mutable std::atomic<quint64> m_misses;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_HOST_VERDICT_CACHE_H
@@ -1,170 +1,307 @@
 #include "IdleInhibitor.h"
+#include "Logging.h"
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
-#include <QtCore/QProcess>
-#include <QtCore/QTimer>
 
 #ifdef Q_OS_LINUX
 #include <QtDBus/QDBusConnection>
-#include <QtDBus/QDBusInterface>
-#include <QtDBus/QDBusReply>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusUnixFileDescriptor>
+#endif
+
+#ifdef SEB_HAVE_XSS
+#include <X11/Xlib.h>
+#include <X11/extensions/scrnsaver.h>
+// Xlib macros that collide with Qt names
+#undef None
+#undef Bool
+#undef Status
 #endif
 
 namespace seb {
 namespace core {
 
-IdleInhibitor::IdleInhibitor(QObject* parent)
-    : QObject(parent)
-    , m_isInhibiting(false)
-    , m_keepAliveTimer(nullptr)
+namespace {
+
+const char InhibitReason[] = "Safe Exam Browser - preventing idle during exam";
+
 #ifdef Q_OS_LINUX
-    , m_inhibitCookie(0)
-    , m_usingDBus(false)
+// Portal and GNOME session manager inhibit flag for idle
+constexpr uint IdleFlag = 8;
+
+QDBusMessage inhibitCall(IdleInhibitor::Backend backend) {
+    const QString app = QCoreApplication::applicationName();
+    const QString reason = QLatin1String(InhibitReason);
+
+    switch (backend) {
+    case IdleInhibitor::Backend::Portal: {
+        QDBusMessage msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.freedesktop.portal.Desktop"), QStringLiteral("/org/freedesktop/portal/desktop"),
+            QStringLiteral("org.freedesktop.portal.Inhibit"), QStringLiteral("Inhibit"));
+        QVariantMap options;
+        options.insert(QStringLiteral("reason"), reason);
+        msg << QString() << IdleFlag << options;
+        return msg;
+    }
+    case IdleInhibitor::Backend::ScreenSaver: {
+        QDBusMessage msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.freedesktop.ScreenSaver"), QStringLiteral("/ScreenSaver"),
+            QStringLiteral("org.freedesktop.ScreenSaver"), QStringLiteral("Inhibit"));
+        msg << app << reason;
+        return msg;
+    }
+    case IdleInhibitor::Backend::GnomeSessionManager: {
+        // Inhibit(app_id, toplevel_xid, reason, flags)
+        QDBusMessage msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.gnome.SessionManager"), QStringLiteral("/org/gnome/SessionManager"),
+            QStringLiteral("org.gnome.SessionManager"), QStringLiteral("Inhibit"));
+        msg << app << 0u << reason << IdleFlag;
+        return msg;
+    }
+    case IdleInhibitor::Backend::Logind: {
+        // Inhibit(what, who, why, mode); the lock is held by the returned fd
+        QDBusMessage msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.freedesktop.login1"), QStringLiteral("/org/freedesktop/login1"),
+            QStringLiteral("org.freedesktop.login1.Manager"), QStringLiteral("Inhibit"));
+        msg << QStringLiteral("idle") << app << reason << QStringLiteral("block");
+        return msg;
+    }
+    case IdleInhibitor::Backend::None:
+    case IdleInhibitor::Backend::XScreenSaver:
+        break;
+    }
+    return QDBusMessage();
+}
+
+QDBusConnection busFor(IdleInhibitor::Backend backend) {
+    return backend == IdleInhibitor::Backend::Logind ? QDBusConnection::systemBus()
+                                                     : QDBusConnection::sessionBus();
+}
 #endif
+
+} // namespace
+
+IdleInhibitor::IdleInhibitor(QObject* parent)
+    : QObject(parent)
+    , m_started(false)
+    , m_pendingReplies(0)
+    , m_backend(Backend::None)
+    , m_xDisplay(nullptr)
 {
-    m_keepAliveTimer = new QTimer(this);
-    m_keepAliveTimer->setSingleShot(false);
-    m_keepAliveTimer->setInterval(30000); // 30 seconds
-    connect(m_keepAliveTimer, &QTimer::timeout, this, &IdleInhibitor::keepAlive);
 }
 
 IdleInhibitor::~IdleInhibitor() {
     stop();
 }
 
+QString IdleInhibitor::backendName(Backend backend) {
+    switch (backend) {
+    case Backend::None: return QStringLiteral("none");
+    case Backend::Portal: return QStringLiteral("org.freedesktop.portal.Inhibit");
+    case Backend::ScreenSaver: return QStringLiteral("org.freedesktop.ScreenSaver");
+    case Backend::GnomeSessionManager: return QStringLiteral("org.gnome.SessionManager");
+    case Backend::Logind: return QStringLiteral("org.freedesktop.login1");
+    case Backend::XScreenSaver: return QStringLiteral("XScreenSaverSuspend");
+    }
+    return QString();
+}
+
 void IdleInhibitor::start() {
-    if (m_isInhibiting) {
+    if (m_started) {
         return;
     }
+    m_started = true;
+
+    qCDebug(lcIdle) << "Starting idle inhibition";
 
-    qDebug() << "Starting idle inhibition";
-    
-    // Try D-Bus first (Linux)
 #ifdef Q_OS_LINUX
-    if (tryDBusInhibit()) {
-        m_usingDBus = true;
-        m_isInhibiting = true;
-        qDebug() << "Idle inhibition active via D-Bus";
-        return;
+    // All at once: the slowest or wedged service must not delay the others
+    const Backend backends[] = {
+        Backend::Portal, Backend::ScreenSaver, Backend::GnomeSessionManager, Backend::Logind
+    };
+    for (Backend backend : backends) {
+        QDBusConnection bus = busFor(backend);
+        if (!bus.isConnected()) {
+            qCDebug(lcIdle) << "No bus for" << backendName(backend);
+            continue;
+        }
+        QDBusPendingCallWatcher* watcher =
+            new QDBusPendingCallWatcher(bus.asyncCall(inhibitCall(backend), CallTimeoutMs), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, backend](QDBusPendingCallWatcher* w) {
+            handleReply(backend, w);
+        });
+        ++m_pendingReplies;
     }
 #endif
 
-    // Fallback to timer-based approach
-    fallbackTimer();
-    m_isInhibiting = true;
-    qDebug() << "Idle inhibition active via keep-alive timer";
+    if (m_pendingReplies == 0) {
+        allRepliesReceived();
+    }
 }
 
 void IdleInhibitor::stop() {
-    if (!m_isInhibiting) {
+    if (!m_started) {
         return;
     }
+    m_started = false;
+
+    qCDebug(lcIdle) << "Stopping idle inhibition";
+
+    // Replies still in flight are released as they arrive
+    if (m_backend == Backend::XScreenSaver) {
+        resumeXScreenSaver();
+    } else if (m_backend != Backend::None && m_backend != Backend::Logind) {
+        release(m_backend, m_token);
+    }
+    if (m_logindLock.isValid()) {
+        release(Backend::Logind, m_logindLock);
+    }
+    m_backend = Backend::None;
+    m_token.clear();
+    m_logindLock.clear();
+}
+
+void IdleInhibitor::handleReply(Backend backend, QDBusPendingCallWatcher* watcher) {
+    watcher->deleteLater();
+    --m_pendingReplies;
 
-    qDebug() << "Stopping idle inhibition";
-    
 #ifdef Q_OS_LINUX
-    if (m_usingDBus) {
-        uninhibitIdle();
-        m_usingDBus = false;
+    const QDBusMessage reply = watcher->reply();
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        qCDebug(lcIdle) << backendName(backend) << "unavailable:" << reply.errorName() << reply.errorMessage();
+    } else {
+        QVariant token = reply.arguments().constFirst();
+        if (backend == Backend::Portal) {
+            token = token.value<QDBusObjectPath>().path();
+        }
+
+        if (!m_started) {
+            release(backend, token);
+        } else if (backend == Backend::Logind) {
+            // Does not keep the screen on by itself; held alongside
+            m_logindLock = token;
+            qCDebug(lcIdle) << "Holding" << backendName(backend) << "idle lock";
+        } else if (m_backend == Backend::None) {
+            activate(backend, token);
+        } else {
+            // Lost the race
+            release(backend, token);
+        }
     }
+#else
+    Q_UNUSED(backend);
 #endif
 
-    if (m_keepAliveTimer->isActive()) {
-        m_keepAliveTimer->stop();
+    if (m_pendingReplies == 0) {
+        allRepliesReceived();
+    }
+}
+
+void IdleInhibitor::release(Backend backend, const QVariant& token) {
+#ifdef Q_OS_LINUX
+    QDBusMessage msg;
+    switch (backend) {
+    case Backend::Portal:
+        msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.freedesktop.portal.Desktop"), token.toString(),
+            QStringLiteral("org.freedesktop.portal.Request"), QStringLiteral("Close"));
+        break;
+    case Backend::ScreenSaver:
+        msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.freedesktop.ScreenSaver"), QStringLiteral("/ScreenSaver"),
+            QStringLiteral("org.freedesktop.ScreenSaver"), QStringLiteral("UnInhibit"));
+        msg << token.toUInt();
+        break;
+    case Backend::GnomeSessionManager:
+        msg = QDBusMessage::createMethodCall(
+            QStringLiteral("org.gnome.SessionManager"), QStringLiteral("/org/gnome/SessionManager"),
+            QStringLiteral("org.gnome.SessionManager"), QStringLiteral("Uninhibit"));
+        msg << token.toUInt();
+        break;
+    case Backend::Logind:
+        // Dropping the last copy of the descriptor releases the lock
+        qCDebug(lcIdle) << "Released idle inhibition via" << backendName(backend);
+        return;
+    case Backend::None:
+    case Backend::XScreenSaver:
+        return;
     }
 
-    m_isInhibiting = false;
+    // Fire and forget; the service also drops it when we leave the bus
+    busFor(backend).call(msg, QDBus::NoBlock);
+    qCDebug(lcIdle) << "Released idle inhibition via" << backendName(backend);
+#else
+    Q_UNUSED(backend);
+    Q_UNUSED(token);
+#endif
 }
 
-void IdleInhibitor::keepAlive() {
-    // Send a keep-alive signal to prevent idle
-    // This can be done via xset or similar commands, or just keep the timer running
-    qDebug() << "Keep-alive ping to prevent idle";
+void IdleInhibitor::activate(Backend backend, const QVariant& token) {
+    m_backend = backend;
+    m_token = token;
+    qCDebug(lcIdle) << "Idle inhibition active via" << backendName(backend);
+    emit inhibited(backend);
 }
 
-#ifdef Q_OS_LINUX
-bool IdleInhibitor::tryDBusInhibit() {
-    QDBusConnection bus = QDBusConnection::sessionBus();
-    
-    // Try org.freedesktop.ScreenSaver (X11/legacy)
-    QDBusInterface screensaver("org.freedesktop.ScreenSaver",
-                              "/ScreenSaver",
-                              "org.freedesktop.ScreenSaver",
-                              bus);
-    
-    if (screensaver.isValid()) {
-        QDBusReply<uint> reply = screensaver.call("Inhibit",
-                                                   QCoreApplication::applicationName(),
-                                                   "Safe Exam Browser - preventing idle during exam");
-        if (reply.isValid()) {
-            m_inhibitCookie = reply.value();
-            qDebug() << "Inhibited idle via org.freedesktop.ScreenSaver, cookie:" << m_inhibitCookie;
-            return true;
-        }
-    }
-    
-    // Try org.gnome.SessionManager (GNOME)
-    QDBusInterface sessionManager("org.gnome.SessionManager",
-                                  "/org/gnome/SessionManager",
-                                  "org.gnome.SessionManager",
-                                  bus);
-    
-    if (sessionManager.isValid()) {
-        QDBusReply<uint> reply = sessionManager.call("Inhibit",
-                                                     QCoreApplication::applicationName(),
-                                                     0u, // flags: 0 = inhibit idle
-                                                     "Safe Exam Browser",
-                                                     "Preventing idle during exam");
-        if (reply.isValid()) {
-            m_inhibitCookie = reply.value();
-            qDebug() << "Inhibited idle via org.gnome.SessionManager, cookie:" << m_inhibitCookie;
-            return true;
-        }
+void IdleInhibitor::allRepliesReceived() {
+    if (!m_started || m_backend != Backend::None) {
+        return;
     }
-    
-    // Note: org.freedesktop.login1 requires system bus and special permissions
-    // Skipping for now - session bus methods should work for most desktop environments
-    
-    return false;
-}
 
-void IdleInhibitor::uninhibitIdle() {
-    QDBusConnection bus = QDBusConnection::sessionBus();
-    
-    // Try org.freedesktop.ScreenSaver
-    QDBusInterface screensaver("org.freedesktop.ScreenSaver",
-                                "/ScreenSaver",
-                                "org.freedesktop.ScreenSaver",
-                                bus);
-    
-    if (screensaver.isValid()) {
-        screensaver.call("UnInhibit", m_inhibitCookie);
-        qDebug() << "Uninhibited idle via org.freedesktop.ScreenSaver";
+    if (suspendXScreenSaver()) {
+        activate(Backend::XScreenSaver, QVariant());
         return;
     }
-    
-    // Try org.gnome.SessionManager
-    QDBusInterface sessionManager("org.gnome.SessionManager",
-                                  "/org/gnome/SessionManager",
-                                  "org.gnome.SessionManager",
-                                  bus);
-    
-    if (sessionManager.isValid()) {
-        sessionManager.call("Uninhibit", m_inhibitCookie);
-        qDebug() << "Uninhibited idle via org.gnome.SessionManager";
+
+    if (m_logindLock.isValid()) {
+        qCWarning(lcIdle) << "Only the logind idle lock is held; the session may still blank or lock";
+        activate(Backend::Logind, QVariant());
+        return;
     }
+
+    qCWarning(lcIdle) << "No idle inhibition backend available; the session may blank or lock";
+    emit failed();
 }
+
+bool IdleInhibitor::suspendXScreenSaver() {
+#ifdef SEB_HAVE_XSS
+    if (qEnvironmentVariableIsEmpty("DISPLAY")) {
+        return false;
+    }
+
+    // A connection of our own: the suspension lasts as long as it is open
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return false;
+    }
+    int eventBase = 0;
+    int errorBase = 0;
+    if (!XScreenSaverQueryExtension(display, &eventBase, &errorBase)) {
+        XCloseDisplay(display);
+        return false;
+    }
+    XScreenSaverSuspend(display, True);
+    XFlush(display);
+    m_xDisplay = display;
+    return true;
+#else
+    return false;
 #endif
+}
 
-void IdleInhibitor::fallbackTimer() {
-    // Start a timer that periodically "pings" to prevent idle
-    // This is a fallback when D-Bus is not available
-    if (!m_keepAliveTimer->isActive()) {
-        m_keepAliveTimer->start();
-        keepAlive(); // Call immediately
+void IdleInhibitor::resumeXScreenSaver() {
+#ifdef SEB_HAVE_XSS
+    Display* display = static_cast<Display*>(m_xDisplay);
+    if (display) {
+        XScreenSaverSuspend(display, False);
+        XCloseDisplay(display);
+        m_xDisplay = nullptr;
+        qCDebug(lcIdle) << "Released idle inhibition via" << backendName(Backend::XScreenSaver);
     }
+#endif
 }
 
 } // namespace core
 } // namespace seb
-
@@ -2,42 +2,74 @@
 #define SEB_CORE_IDLE_INHIBITOR_H
 
 #include <QtCore/QObject>
-#include <QtCore/QTimer>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+class QDBusPendingCallWatcher;
 
 namespace seb {
 namespace core {
 
+// Keeps the session from idling (screen blanking, locking) during the exam.
+//
+// start() never blocks: inhibit requests go out in parallel to the
+// xdg-desktop-portal, org.freedesktop.ScreenSaver, the GNOME session
+// manager and logind with a short timeout. Only the session-side services
+// stop screen blanking and locking: the first of them that succeeds is
+// kept and later successes are released again. If none succeeds, the X
+// screen saver is suspended for this client (XScreenSaverSuspend) where
+// available. A logind `idle` lock is held in addition whenever granted,
+// and is the backend of last resort.
 class IdleInhibitor : public QObject {
     Q_OBJECT
 
 public:
+    enum class Backend {
+        None,
+        Portal,
+        ScreenSaver,
+        GnomeSessionManager,
+        Logind,
+        XScreenSaver
+    };
+    Q_ENUM(Backend)
+
+    // Per D-Bus call; a wedged service costs this much, not the 25 s default
+    static constexpr int CallTimeoutMs = 2000;
+
     explicit IdleInhibitor(QObject* parent = nullptr);
     ~IdleInhibitor() override;
 
-    bool isInhibiting() const { return m_isInhibiting; }
+    bool isInhibiting() const { return m_backend != Backend::None; }
+    Backend backend() const { return m_backend; }
+    static QString backendName(Backend backend);
+
     void start();
     void stop();
 
-private slots:
-    void keepAlive();
+signals:
+    // A session backend succeeded, or only the fallbacks were left
+    void inhibited(seb::core::IdleInhibitor::Backend backend);
+    // No backend succeeded; the session may idle
+    void failed();
 
 private:
-    void inhibitIdle();
-    void uninhibitIdle();
-    bool tryDBusInhibit();
-    void fallbackTimer();
-
-    bool m_isInhibiting;
-    QTimer* m_keepAliveTimer;
-    
-#ifdef Q_OS_LINUX
-    uint m_inhibitCookie;
-    bool m_usingDBus;
-#endif
+    void handleReply(Backend backend, QDBusPendingCallWatcher* watcher);
+    void release(Backend backend, const QVariant& token);
+    void activate(Backend backend, const QVariant& token);
+    void allRepliesReceived();
+    bool suspendXScreenSaver();
+    void resumeXScreenSaver();
+
+    bool m_started;
+    int m_pendingReplies;
+    Backend m_backend;
+    QVariant m_token;              // Cookie or portal request path
+    QVariant m_logindLock;         // Lock fd, held next to the session backend
+    void* m_xDisplay;              // Own X connection holding the suspension
 };
 
 } // namespace core
 } // namespace seb
 
 #endif // SEB_CORE_IDLE_INHIBITOR_H
-
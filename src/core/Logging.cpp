@@ -0,0 +1,278 @@
+#include "Logging.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QHashFunctions>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QString>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace seb {
+namespace core {
+
+Q_LOGGING_CATEGORY(lcConfig, "seb.config")
+Q_LOGGING_CATEGORY(lcIdle, "seb.idle")
+Q_LOGGING_CATEGORY(lcNavigation, "seb.navigation")
+Q_LOGGING_CATEGORY(lcPrefetch, "seb.prefetch")
+Q_LOGGING_CATEGORY(lcProxy, "seb.proxy")
+Q_LOGGING_CATEGORY(lcRequest, "seb.request")
+Q_LOGGING_CATEGORY(lcResources, "seb.resources")
+Q_LOGGING_CATEGORY(lcStartLoad, "seb.startload")
+Q_LOGGING_CATEGORY(lcTrace, "seb.trace")
+Q_LOGGING_CATEGORY(lcWindow, "seb.window")
+
+namespace {
+
+constexpr size_t RingSize = 1024;      // Power of two
+
+// Bounded multi-producer queue of log records (Vyukov): a record's sequence
+// number tells producers and the consumer whose turn it is. Records keep
+// the unformatted message (implicitly shared, so pushing does not copy it)
+// and the context strings, which point to static storage.
+struct Record {
+    std::atomic<size_t> sequence;
+    QtMsgType type;
+    int line;
+    const char* file;
+    const char* function;
+    const char* category;
+    QString message;
+};
+
+class LogRing {
+public:
+    LogRing() {
+        for (size_t i = 0; i < RingSize; ++i) {
+            m_records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread; returns false instead of waiting when the ring is full
+    bool push(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        Record* record;
+        for (;;) {
+            record = &m_records[position & (RingSize - 1)];
+            const size_t sequence = record->sequence.load(std::memory_order_acquire);
+            const qptrdiff difference = qptrdiff(sequence) - qptrdiff(position);
+            if (difference == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->type = type;
+        record->line = context.line;
+        record->file = context.file;
+        record->function = context.function;
+        record->category = context.category;
+        record->message = message;
+        record->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer at a time (serialized by the caller); formats the record
+    bool pop(QByteArray& text) {
+        const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        Record& record = m_records[position & (RingSize - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        const QMessageLogContext context(record.file, record.line, record.function, record.category);
+        text = qFormatLogMessage(record.type, context, record.message).toUtf8();
+        record.message = QString();
+        record.sequence.store(position + RingSize, std::memory_order_release);
+        m_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool isEmpty() const {
+        const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        return m_records[position & (RingSize - 1)].sequence.load(std::memory_order_acquire) != position + 1;
+    }
+
+private:
+    Record m_records[RingSize];
+    alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(64) std::atomic<size_t> m_dequeuePosition{0};
+};
+
+struct LogState {
+    LogRing ring;
+    QMutex drainMutex;
+    std::thread writer;
+    std::atomic<bool> running{false};
+    std::atomic<quint64> dropped{0};
+    quint64 reportedDropped = 0;
+    QtMessageHandler previousHandler = nullptr;
+
+    // The writer sleeps until a producer sees this flag set
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> writerWaiting{false};
+
+    void wakeWriter() {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        writerWaiting.store(false, std::memory_order_relaxed);
+        wake.notify_one();
+    }
+
+    ~LogState() {
+        // Qt may still log during its own teardown; stop routing it here
+        // before the ring is gone. Covers exits without shutdown().
+        if (writer.joinable()) {
+            qInstallMessageHandler(previousHandler);
+            running.store(false, std::memory_order_release);
+            wakeWriter();
+            writer.join();
+        }
+    }
+};
+
+LogState& logState() {
+    static LogState state;
+    return state;
+}
+
+void writeLine(const QByteArray& text) {
+    std::fwrite(text.constData(), 1, size_t(text.size()), stderr);
+    std::fputc('\n', stderr);
+}
+
+// Write everything queued so far; returns false if there was nothing
+bool drain() {
+    LogState& state = logState();
+    QMutexLocker locker(&state.drainMutex);
+
+    bool wrote = false;
+    QByteArray text;
+    while (state.ring.pop(text)) {
+        writeLine(text);
+        wrote = true;
+    }
+
+    const quint64 dropped = state.dropped.load(std::memory_order_relaxed);
+    if (dropped != state.reportedDropped) {
+        writeLine(QByteArray("seb.log: dropped ") + QByteArray::number(dropped - state.reportedDropped)
+                  + " messages (log buffer full)");
+        state.reportedDropped = dropped;
+        wrote = true;
+    }
+
+    if (wrote) {
+        std::fflush(stderr);
+    }
+    return wrote;
+}
+
+void writerLoop() {
+    LogState& state = logState();
+    while (state.running.load(std::memory_order_acquire)) {
+        if (drain()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state.wakeMutex);
+        state.writerWaiting.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in messageHandler: either the producer sees
+        // the flag or this check sees its record
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state.ring.isEmpty() && state.running.load(std::memory_order_acquire)) {
+            state.wake.wait(lock, [&state]() {
+                return !state.writerWaiting.load(std::memory_order_relaxed);
+            });
+        }
+        state.writerWaiting.store(false, std::memory_order_relaxed);
+    }
+    drain();
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    LogState& state = logState();
+
+    if (type == QtCriticalMsg || type == QtFatalMsg || !state.running.load(std::memory_order_acquire)) {
+        drain();
+        const QByteArray text = qFormatLogMessage(type, context, message).toUtf8();
+        QMutexLocker locker(&state.drainMutex);
+        writeLine(text);
+        std::fflush(stderr);
+        return;
+    }
+
+    if (!state.ring.push(type, context, message)) {
+        state.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state.writerWaiting.load(std::memory_order_relaxed)) {
+        state.wakeWriter();
+    }
+}
+
+} // namespace
+
+void AsyncLog::install() {
+    LogState& state = logState();
+    if (state.running.exchange(true)) {
+        return;
+    }
+    state.previousHandler = qInstallMessageHandler(messageHandler);
+    // A plain thread: the writer has to outlive QApplication
+    state.writer = std::thread(writerLoop);
+}
+
+void AsyncLog::shutdown() {
+    LogState& state = logState();
+    if (!state.running.exchange(false)) {
+        return;
+    }
+    state.wakeWriter();
+    state.writer.join();
+    qInstallMessageHandler(state.previousHandler);
+    drain();
+}
+
+quint64 AsyncLog::droppedCount() {
+    return logState().dropped.load(std::memory_order_relaxed);
+}
+
+LogThrottle::LogThrottle(int capacity)
+    : m_mask(0)
+    , m_seed(size_t(QRandomGenerator::system()->generate64()))
+{
+    int size = 16;
+    while (size < capacity) {
+        size *= 2;
+    }
+    m_mask = quint64(size - 1);
+    m_slots.reset(new Slot[size]);
+    for (int i = 0; i < size; ++i) {
+        m_slots[i].tag.store(0, std::memory_order_relaxed);
+        m_slots[i].count.store(0, std::memory_order_relaxed);
+    }
+}
+
+quint64 LogThrottle::record(QStringView key) {
+    const quint64 tag = quint64(qHash(key, m_seed)) | 1;
+    Slot& slot = m_slots[(tag >> 1) & m_mask];
+
+    // A different key took over the slot: start counting again
+    quint64 current = slot.tag.load(std::memory_order_acquire);
+    if (current != tag && slot.tag.compare_exchange_strong(current, tag, std::memory_order_acq_rel)) {
+        slot.count.store(0, std::memory_order_relaxed);
+    }
+
+    const quint64 count = slot.count.fetch_add(1, std::memory_order_relaxed) + 1;
+    return (count & (count - 1)) == 0 ? count : 0;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,76 @@
+#ifndef SEB_CORE_LOGGING_H
+#define SEB_CORE_LOGGING_H
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QStringView>
+#include <QtCore/QtGlobal>
+#include <atomic>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+// Logging categories; filter with QT_LOGGING_RULES, e.g. "seb.request.warning=false"
+Q_DECLARE_LOGGING_CATEGORY(lcConfig)
+Q_DECLARE_LOGGING_CATEGORY(lcIdle)
+Q_DECLARE_LOGGING_CATEGORY(lcNavigation)
+Q_DECLARE_LOGGING_CATEGORY(lcPrefetch)
+Q_DECLARE_LOGGING_CATEGORY(lcProxy)
+Q_DECLARE_LOGGING_CATEGORY(lcRequest)
+Q_DECLARE_LOGGING_CATEGORY(lcResources)
+Q_DECLARE_LOGGING_CATEGORY(lcStartLoad)
+Q_DECLARE_LOGGING_CATEGORY(lcTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcWindow)
+
+// Asynchronous sink for all Qt log output.
+//
+// The installed message handler pushes the unformatted message and its
+// context into a bounded lock-free ring buffer; a background writer, woken
+// when it sleeps, formats the records and drains them to stderr. Logging
+// threads (notably the Chromium IO thread running the request interceptor)
+// neither format nor block on terminal or journal writes, so placeholders
+// such as %{time} or %{threadid} in QT_MESSAGE_PATTERN are evaluated by the
+// writer. Messages are never truncated. When the ring is full, messages are
+// dropped and the number of dropped messages is reported once there is
+// room. Critical and fatal messages are formatted and written
+// synchronously, after everything queued before them, so they are not lost
+// when the process exits right afterwards.
+class AsyncLog {
+public:
+    // Install the handler and start the writer; call before QApplication
+    static void install();
+
+    // Write all queued messages, stop the writer and restore the previous handler
+    static void shutdown();
+
+    static quint64 droppedCount();
+};
+
+// Duplicate suppression for repetitive log messages.
+//
+// record() counts occurrences per key and returns the count on the 1st,
+// 2nd, 4th, 8th, ... occurrence and 0 otherwise, so a host blocked 512
+// times logs ten lines ("... 512 times") instead of 512. Counters live in a
+// fixed table of atomics indexed by a keyed hash: lock-free and
+// allocation-free, and approximate when keys collide.
+class LogThrottle {
+public:
+    explicit LogThrottle(int capacity = 256);
+
+    quint64 record(QStringView key);
+
+private:
+    struct Slot {
+        std::atomic<quint64> tag;
+        std::atomic<quint64> count;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    quint64 m_mask;
+    size_t m_seed;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_LOGGING_H
@@ -0,0 +1,192 @@
+#include "Metrics.h"
+#include <QtCore/QString>
+#include <QtCore/QtAlgorithms>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+// Exported bucket bounds: powers of two from 128 ns to 2^36 ns (~68 s)
+constexpr int FirstExportedExponent = 7;
+
+const char* const RendererStatusNames[4] = {"normal", "abnormal", "crashed", "killed"};
+
+int highestBit(quint64 value) {
+    return 63 - int(qCountLeadingZeroBits(value));
+}
+
+QByteArray seconds(double nanoseconds) {
+    return QByteArray::number(nanoseconds / 1e9, 'g', 9);
+}
+
+void appendHeader(QByteArray& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+void appendHistogram(QByteArray& out, const char* name, const QByteArray& labels, const LatencyHistogram& histogram) {
+    const QByteArray prefix = QByteArray(name) + "_bucket{" + labels + (labels.isEmpty() ? "" : ",") + "le=\"";
+
+    // One walk over the buckets: the exported series stay cumulative and
+    // consistent with +Inf and _count while requests are being recorded
+    quint64 cumulative = 0;
+    int exponent = FirstExportedExponent;
+    for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+        cumulative += histogram.bucketValueCount(i);
+        const qint64 bound = qint64(1) << exponent;
+        if (exponent <= LatencyHistogram::MaxExponent && LatencyHistogram::bucketUpperBound(i) == bound) {
+            out += prefix + seconds(double(bound)) + "\"} " + QByteArray::number(cumulative) + '\n';
+            ++exponent;
+        }
+    }
+    const QByteArray count = QByteArray::number(cumulative);
+    out += prefix + "+Inf\"} " + count + '\n';
+
+    const QByteArray braces = labels.isEmpty() ? QByteArray() : "{" + labels + "}";
+    out += QByteArray(name) + "_sum" + braces + ' ' + seconds(double(histogram.sumNanoseconds())) + '\n';
+    out += QByteArray(name) + "_count" + braces + ' ' + count + '\n';
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : m_count(0)
+    , m_sum(0)
+{
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(qint64 nanoseconds) {
+    // Buckets cover (lower, upper]: classify the value just below
+    const qint64 value = nanoseconds - 1;
+    if (value < SubBucketCount) {
+        return int(qMax<qint64>(value, 0));
+    }
+    const int exponent = highestBit(quint64(value));
+    if (exponent > MaxExponent) {
+        return BucketCount - 1;
+    }
+    // Top bit selects the power of two, the next three bits the sub-bucket
+    const int shift = exponent - SubBucketBits;
+    const int subBucket = int((quint64(value) >> shift) & (SubBucketCount - 1));
+    return (shift + 1) * SubBucketCount + subBucket;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SubBucketCount) {
+        return index + 1;
+    }
+    const int shift = index / SubBucketCount - 1;
+    const int subBucket = index % SubBucketCount;
+    return qint64(SubBucketCount + subBucket + 1) << shift;
+}
+
+void LatencyHistogram::record(qint64 nanoseconds) {
+    m_buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(quint64(qMax<qint64>(nanoseconds, 0)), std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::valueAtQuantile(double quantile) const {
+    const quint64 total = count();
+    if (total == 0) {
+        return 0;
+    }
+    const quint64 target = qMax<quint64>(1, quint64(quantile * double(total) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BucketCount - 1);
+}
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+void Metrics::recordRequest(bool blocked, int resourceType, qint64 latencyNs) {
+    m_requestLatency[blocked ? 1 : 0][ResourceType::slot(resourceType)].record(latencyNs);
+}
+
+Metrics::RequestTotals Metrics::requestTotals() const {
+    RequestTotals totals;
+    for (int slot = 0; slot < ResourceType::SlotCount; ++slot) {
+        totals.allowed += m_requestLatency[0][slot].count();
+        totals.blocked += m_requestLatency[1][slot].count();
+        totals.totalNs += m_requestLatency[0][slot].sumNanoseconds() + m_requestLatency[1][slot].sumNanoseconds();
+    }
+    return totals;
+}
+
+void Metrics::recordNavigation(bool blocked) {
+    m_navigations[blocked ? 1 : 0].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordBlockPage() {
+    m_blockPages.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordRendererTermination(int status) {
+    m_rendererTerminations[qBound(0, status, 3)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordLoad(LoadResult result, qint64 durationNs) {
+    m_loadTime[result == LoadResult::Succeeded ? 0 : 1].record(durationNs);
+}
+
+QByteArray Metrics::toPrometheus() const {
+    QByteArray out;
+    out.reserve(16 * 1024);
+
+    appendHeader(out, "seb_request_duration_seconds", "histogram",
+                 "Time spent in the request interceptor per request");
+    for (int verdict = 0; verdict < 2; ++verdict) {
+        for (int slot = 0; slot < ResourceType::SlotCount; ++slot) {
+            const LatencyHistogram& histogram = m_requestLatency[verdict][slot];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            const QByteArray labels = QByteArray("verdict=\"") + (verdict ? "blocked" : "allowed")
+                                    + "\",resource_type=\"" + ResourceType::name(slot) + '"';
+            appendHistogram(out, "seb_request_duration_seconds", labels, histogram);
+        }
+    }
+
+    appendHeader(out, "seb_navigations_total", "counter", "Main frame navigations by policy verdict");
+    out += "seb_navigations_total{verdict=\"allowed\"} "
+         + QByteArray::number(m_navigations[0].load(std::memory_order_relaxed)) + '\n';
+    out += "seb_navigations_total{verdict=\"blocked\"} "
+         + QByteArray::number(m_navigations[1].load(std::memory_order_relaxed)) + '\n';
+
+    appendHeader(out, "seb_block_pages_total", "counter", "Block pages shown");
+    out += "seb_block_pages_total " + QByteArray::number(m_blockPages.load(std::memory_order_relaxed)) + '\n';
+
+    appendHeader(out, "seb_renderer_terminations_total", "counter", "Renderer process terminations by status");
+    for (int status = 0; status < 4; ++status) {
+        out += QByteArray("seb_renderer_terminations_total{status=\"") + RendererStatusNames[status] + "\"} "
+             + QByteArray::number(m_rendererTerminations[status].load(std::memory_order_relaxed)) + '\n';
+    }
+
+    appendHeader(out, "seb_page_load_duration_seconds", "histogram", "Main frame page load time");
+    appendHistogram(out, "seb_page_load_duration_seconds", "result=\"succeeded\"", m_loadTime[0]);
+    appendHistogram(out, "seb_page_load_duration_seconds", "result=\"failed\"", m_loadTime[1]);
+
+    return out;
+}
+
+} // namespace core
+} // namespace seb
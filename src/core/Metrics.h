@@ -0,0 +1,90 @@
+#ifndef SEB_CORE_METRICS_H
+#define SEB_CORE_METRICS_H
+
+#include "ResourceType.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QtGlobal>
+#include <atomic>
+
+namespace seb {
+namespace core {
+
+// Lock-free latency histogram with HDR-style log-linear buckets.
+//
+// Each power of two is split into 8 linear sub-buckets (~12% relative
+// precision) from 8 ns up to ~68 s; larger values land in the last bucket.
+// Buckets include their upper bound, so every power of two closes a bucket
+// and cumulative counts match Prometheus "le" semantics exactly.
+// record() is three relaxed atomic increments.
+class LatencyHistogram {
+public:
+    static constexpr int SubBucketBits = 3;
+    static constexpr int SubBucketCount = 1 << SubBucketBits;
+    static constexpr int MaxExponent = 36;
+    static constexpr int BucketCount = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+    LatencyHistogram();
+
+    void record(qint64 nanoseconds);
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    quint64 sumNanoseconds() const { return m_sum.load(std::memory_order_relaxed); }
+
+    // Values recorded in one bucket; sum buckets rather than mixing with
+    // count(), which concurrent recording may have moved on from
+    quint64 bucketValueCount(int index) const { return m_buckets[index].load(std::memory_order_relaxed); }
+
+    // Approximate value at the given quantile (0..1), in nanoseconds
+    qint64 valueAtQuantile(double quantile) const;
+
+    static int bucketIndex(qint64 nanoseconds);
+    static qint64 bucketUpperBound(int index);  // Inclusive
+
+private:
+    std::atomic<quint64> m_buckets[BucketCount];
+    std::atomic<quint64> m_count;
+    std::atomic<quint64> m_sum;
+};
+
+// Process-wide counters and histograms, exported in the Prometheus text
+// format. Recording never locks or allocates.
+class Metrics {
+public:
+    enum class LoadResult {
+        Succeeded,
+        Failed
+    };
+
+    struct RequestTotals {
+        quint64 allowed = 0;
+        quint64 blocked = 0;
+        quint64 totalNs = 0;       // Time spent in the interceptor
+    };
+
+    static Metrics& instance();
+
+    void recordRequest(bool blocked, int resourceType, qint64 latencyNs);
+    void recordNavigation(bool blocked);
+    void recordBlockPage();
+    void recordRendererTermination(int status);
+    void recordLoad(LoadResult result, qint64 durationNs);
+
+    // Interceptor requests summed over all resource types
+    RequestTotals requestTotals() const;
+
+    QByteArray toPrometheus() const;
+
+private:
+    Metrics() = default;
+
+    LatencyHistogram m_requestLatency[2][ResourceType::SlotCount];
+    std::atomic<quint64> m_navigations[2] = {};
+    std::atomic<quint64> m_blockPages{0};
+    std::atomic<quint64> m_rendererTerminations[4] = {};
+    LatencyHistogram m_loadTime[2];
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_METRICS_H
@@ -0,0 +1,93 @@
+#include "MetricsExporter.h"
+#include "Logging.h"
+#include "Metrics.h"
+#include "ResourceProfile.h"
+#include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QSaveFile>
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
+
+namespace seb {
+namespace core {
+
+MetricsExporter::MetricsExporter(const MetricsSettings& settings, QObject* parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_server(nullptr)
+{
+    m_timer.setInterval(m_settings.intervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &MetricsExporter::writeTextfile);
+}
+
+MetricsExporter::~MetricsExporter() {
+    // Leave a final snapshot behind for the collector
+    if (!m_settings.textfilePath.isEmpty()) {
+        writeTextfile();
+    }
+}
+
+void MetricsExporter::start() {
+    if (!m_settings.textfilePath.isEmpty()) {
+        writeTextfile();
+        m_timer.start();
+        qCDebug(lcConfig) << "Writing metrics to" << m_settings.textfilePath
+                          << "every" << m_settings.intervalMs << "ms";
+    }
+
+    if (!m_settings.socketPath.isEmpty()) {
+        m_server = new QLocalServer(this);
+        m_server->setSocketOptions(QLocalServer::UserAccessOption);
+        QLocalServer::removeServer(m_settings.socketPath);
+        if (!m_server->listen(m_settings.socketPath)) {
+            qCWarning(lcConfig) << "Cannot listen on metrics socket" << m_settings.socketPath
+                                << ":" << m_server->errorString();
+            return;
+        }
+        connect(m_server, &QLocalServer::newConnection, this, &MetricsExporter::serveConnection);
+        qCDebug(lcConfig) << "Serving metrics on" << m_settings.socketPath;
+    }
+}
+
+QByteArray MetricsExporter::snapshot() {
+    QByteArray out = Metrics::instance().toPrometheus();
+
+    // Memory per WebEngine process type, to compare resource profiles. The
+    // periodic memory report samples /proc; scrapes only reuse its values.
+    const QList<ResourceProfile::ProcessMemory> processes = ResourceProfile::lastProcessMemory();
+    if (processes.isEmpty()) {
+        return out;
+    }
+    QHash<QByteArray, qint64> memoryKb;
+    for (const ResourceProfile::ProcessMemory& process : processes) {
+        const bool pss = process.proportionalKb > 0;
+        const QByteArray labels = "type=\"" + process.type.toLatin1() + "\",measure=\"" + (pss ? "pss" : "rss") + '"';
+        memoryKb[labels] += pss ? process.proportionalKb : process.residentKb;
+    }
+    out += "# HELP seb_process_memory_bytes Memory by process type: proportional set size (measure=\"pss\"), "
+           "or resident set size (measure=\"rss\") for processes whose PSS cannot be read\n"
+           "# TYPE seb_process_memory_bytes gauge\n";
+    for (auto it = memoryKb.cbegin(); it != memoryKb.cend(); ++it) {
+        out += "seb_process_memory_bytes{" + it.key() + "} " + QByteArray::number(it.value() * 1024) + '\n';
+    }
+    return out;
+}
+
+void MetricsExporter::writeTextfile() {
+    // Atomic replace: the collector never reads a half-written file
+    QSaveFile file(m_settings.textfilePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(snapshot()) < 0 || !file.commit()) {
+        qCWarning(lcConfig) << "Cannot write metrics to" << m_settings.textfilePath << ":" << file.errorString();
+    }
+}
+
+void MetricsExporter::serveConnection() {
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        socket->write(snapshot());
+        socket->disconnectFromServer();
+    }
+}
+
+} // namespace core
+} // namespace seb
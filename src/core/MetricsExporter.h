@@ -0,0 +1,41 @@
+#ifndef SEB_CORE_METRICS_EXPORTER_H
+#define SEB_CORE_METRICS_EXPORTER_H
+
+#include "Config.h"
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+class QLocalServer;
+
+namespace seb {
+namespace core {
+
+// Publishes Metrics in the Prometheus text format: periodically rewritten
+// into a textfile (for node_exporter's textfile collector) and/or served to
+// every client connecting to a local Unix socket
+// (e.g. `socat - UNIX-CONNECT:/run/seb/metrics.sock`).
+class MetricsExporter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MetricsExporter(const MetricsSettings& settings, QObject* parent = nullptr);
+    ~MetricsExporter() override;
+
+    void start();
+
+private slots:
+    void writeTextfile();
+    void serveConnection();
+
+private:
+    static QByteArray snapshot();
+
+    MetricsSettings m_settings;
+    QTimer m_timer;
+    QLocalServer* m_server;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_METRICS_EXPORTER_H
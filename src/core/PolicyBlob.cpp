@@ -0,0 +1,433 @@
+#include "PolicyBlob.h"
+#include "Sha256.h"
+#include <QtCore/QDataStream>
+#include <QtCore/QSysInfo>
+#include <QtCore/QtEndian>
+#include <cstring>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+constexpr quint32 BlobMagic = 0x50424553; // "SEBP"
+
+// File header: magic u32, version u16, section count u16, payload size u64,
+// SHA-256 of the payload (everything after the header)
+constexpr int HeaderSize = 48;
+constexpr int MagicOffset = 0;
+constexpr int VersionOffset = 4;
+constexpr int SectionCountOffset = 6;
+constexpr int PayloadSizeOffset = 8;
+constexpr int ChecksumOffset = 16;
+
+// Section entry: id u32, offset u32 (from file start), size u32, reserved u32
+constexpr int SectionEntrySize = 16;
+constexpr int SectionAlignment = 8;
+
+enum SectionId : quint32 {
+    PolicySection = 1,             // QDataStream of the Policy fields
+    DomainNodesSection = 2,        // DomainMatcher::Node[]
+    DomainEdgesSection = 3,        // DomainMatcher::Edge[]
+    DomainLabelsSection = 4,       // UTF-16 label pool
+    UrlFilterSection = 5,          // QDataStream: combined pattern, group actions
+    HeaderIndexSection = 6,        // name offset, name length, value offset, value length (u32)
+    HeaderDataSection = 7          // Header name and value bytes
+};
+
+constexpr SectionId AllSections[] = {
+    PolicySection, DomainNodesSection, DomainEdgesSection, DomainLabelsSection,
+    UrlFilterSection, HeaderIndexSection, HeaderDataSection
+};
+
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_0;
+
+static_assert(sizeof(DomainMatcher::Node) == 12 && sizeof(DomainMatcher::Edge) == 12,
+              "Domain tables are stored in their in-memory layout");
+
+constexpr bool isLittleEndianHost() {
+    return QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+}
+
+void writeUrlFilterRule(QDataStream& out, const UrlFilterRule& rule) {
+    out << rule.expression << rule.regex << rule.active << qint32(rule.action);
+}
+
+void readUrlFilterRule(QDataStream& in, UrlFilterRule& rule) {
+    qint32 action = 0;
+    in >> rule.expression >> rule.regex >> rule.active >> action;
+    rule.action = action == qint32(UrlFilterRule::Action::Block) ? UrlFilterRule::Action::Block
+                                                                 : UrlFilterRule::Action::Allow;
+}
+
+void writeResourceRule(QDataStream& out, const ResourceRule& rule) {
+    out << rule.types << rule.domains << rule.thirdPartyOnly << qint32(rule.action);
+}
+
+void readResourceRule(QDataStream& in, ResourceRule& rule) {
+    qint32 action = 0;
+    in >> rule.types >> rule.domains >> rule.thirdPartyOnly >> action;
+    rule.action = action == qint32(ResourceRule::Action::Allow) ? ResourceRule::Action::Allow
+                                                                : ResourceRule::Action::Block;
+}
+
+void writePolicy(QDataStream& out, const Policy& policy) {
+    out << policy.startUrl << policy.allowedDomains << policy.userAgentSuffix
+        << policy.clientVersion << policy.clientType << policy.sendConfigKey
+        << policy.browserExamKey << policy.configKey;
+
+    const PrefetchSettings& prefetch = policy.prefetch;
+    out << prefetch.urls << prefetch.manifestUrl << qint32(prefetch.concurrency) << qint32(prefetch.jitterMs);
+
+    const StartLoadSettings& startLoad = policy.startLoad;
+    out << qint32(startLoad.spreadMs) << qint32(startLoad.maxRetries)
+        << qint32(startLoad.initialBackoffMs) << qint32(startLoad.maxBackoffMs);
+
+    out << quint32(policy.urlFilterRules.size());
+    for (const UrlFilterRule& rule : policy.urlFilterRules) {
+        writeUrlFilterRule(out, rule);
+    }
+    out << quint32(policy.resourceRules.size());
+    for (const ResourceRule& rule : policy.resourceRules) {
+        writeResourceRule(out, rule);
+    }
+
+    out << policy.reloadOnChange << policy.auditLogPath;
+
+    const MetricsSettings& metrics = policy.metrics;
+    out << metrics.textfilePath << metrics.socketPath << qint32(metrics.intervalMs);
+
+    const ResourceSettings& resources = policy.resources;
+    out << resources.processModel << qint32(resources.rendererProcessLimit) << qint32(resources.jsHeapLimitMb)
+        << resources.disabledFeatures << resources.disableBackgroundNetworking
+        << qint32(resources.httpCacheMb) << qint32(resources.memoryReportIntervalMs);
+
+    const ProxySettings& proxy = policy.proxy;
+    out << proxy.mode << proxy.server << proxy.pacUrl << proxy.bypass;
+
+    const LockdownSettings& lockdown = policy.lockdown;
+    out << lockdown.blockContextMenu << lockdown.blockTextSelection << lockdown.blockClipboard;
+    out << quint32(lockdown.userScripts.size());
+    for (const UserScript& script : lockdown.userScripts) {
+        out << script.path << script.mainWorld << script.atDocumentReady;
+    }
+
+    out << policy.blockedShortcuts;
+}
+
+void readPolicy(QDataStream& in, Policy& policy) {
+    in >> policy.startUrl >> policy.allowedDomains >> policy.userAgentSuffix
+       >> policy.clientVersion >> policy.clientType >> policy.sendConfigKey
+       >> policy.browserExamKey >> policy.configKey;
+
+    auto readInt = [&in](int& value) {
+        qint32 v = 0;
+        in >> v;
+        value = v;
+    };
+
+    PrefetchSettings& prefetch = policy.prefetch;
+    in >> prefetch.urls >> prefetch.manifestUrl;
+    readInt(prefetch.concurrency);
+    readInt(prefetch.jitterMs);
+
+    StartLoadSettings& startLoad = policy.startLoad;
+    readInt(startLoad.spreadMs);
+    readInt(startLoad.maxRetries);
+    readInt(startLoad.initialBackoffMs);
+    readInt(startLoad.maxBackoffMs);
+
+    quint32 ruleCount = 0;
+    in >> ruleCount;
+    policy.urlFilterRules.clear();
+    for (quint32 i = 0; i < ruleCount && in.status() == QDataStream::Ok; ++i) {
+        UrlFilterRule rule;
+        readUrlFilterRule(in, rule);
+        policy.urlFilterRules.append(rule);
+    }
+    in >> ruleCount;
+    policy.resourceRules.clear();
+    for (quint32 i = 0; i < ruleCount && in.status() == QDataStream::Ok; ++i) {
+        ResourceRule rule;
+        readResourceRule(in, rule);
+        policy.resourceRules.append(rule);
+    }
+
+    in >> policy.reloadOnChange >> policy.auditLogPath;
+
+    MetricsSettings& metrics = policy.metrics;
+    in >> metrics.textfilePath >> metrics.socketPath;
+    readInt(metrics.intervalMs);
+
+    ResourceSettings& resources = policy.resources;
+    in >> resources.processModel;
+    readInt(resources.rendererProcessLimit);
+    readInt(resources.jsHeapLimitMb);
+    in >> resources.disabledFeatures >> resources.disableBackgroundNetworking;
+    readInt(resources.httpCacheMb);
+    readInt(resources.memoryReportIntervalMs);
+
+    ProxySettings& proxy = policy.proxy;
+    in >> proxy.mode >> proxy.server >> proxy.pacUrl >> proxy.bypass;
+
+    LockdownSettings& lockdown = policy.lockdown;
+    in >> lockdown.blockContextMenu >> lockdown.blockTextSelection >> lockdown.blockClipboard;
+    quint32 scriptCount = 0;
+    in >> scriptCount;
+    lockdown.userScripts.clear();
+    for (quint32 i = 0; i < scriptCount && in.status() == QDataStream::Ok; ++i) {
+        UserScript script;
+        in >> script.path >> script.mainWorld >> script.atDocumentReady;
+        lockdown.userScripts.append(script);
+    }
+
+    in >> policy.blockedShortcuts;
+}
+
+template <typename Write>
+QByteArray streamed(Write write) {
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(StreamVersion);
+    write(out);
+    return data;
+}
+
+void appendU32(QByteArray& data, quint32 value) {
+    const quint32 le = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+} // namespace
+
+QByteArray PolicyBlob::compile(const Policy& policy, QString* errorString) {
+    auto fail = [errorString](const QString& message) {
+        if (errorString) {
+            *errorString = message;
+        }
+        return QByteArray();
+    };
+
+    if (!isLittleEndianHost()) {
+        return fail("Compiled policies are only supported on little-endian hosts");
+    }
+
+    const UrlFilter urlFilter(policy.urlFilterRules);
+    if (!urlFilter.isValid()) {
+        return fail(urlFilter.errorString());
+    }
+    const DomainMatcher domainMatcher(policy.allowedDomains);
+    const DomainMatcher::Tables domainTables = domainMatcher.tables();
+
+    QByteArray headerIndex;
+    QByteArray headerData;
+    for (const auto& header : RequestHeaders::encode(policy)) {
+        appendU32(headerIndex, quint32(headerData.size()));
+        appendU32(headerIndex, quint32(header.first.size()));
+        headerData += header.first;
+        appendU32(headerIndex, quint32(headerData.size()));
+        appendU32(headerIndex, quint32(header.second.size()));
+        headerData += header.second;
+    }
+
+    const QByteArray sections[] = {
+        streamed([&policy](QDataStream& out) { writePolicy(out, policy); }),
+        domainTables.nodes.toByteArray(),
+        domainTables.edges.toByteArray(),
+        domainTables.labels.toByteArray(),
+        streamed([&urlFilter](QDataStream& out) {
+            out << urlFilter.pattern() << urlFilter.groupActions();
+        }),
+        headerIndex,
+        headerData
+    };
+    constexpr int SectionCount = int(sizeof(AllSections) / sizeof(AllSections[0]));
+
+    QByteArray blob(HeaderSize + SectionCount * SectionEntrySize, '\0');
+    for (int i = 0; i < SectionCount; ++i) {
+        while (blob.size() % SectionAlignment != 0) {
+            blob.append('\0');
+        }
+        uchar* entry = reinterpret_cast<uchar*>(blob.data()) + HeaderSize + i * SectionEntrySize;
+        qToLittleEndian<quint32>(AllSections[i], entry);
+        qToLittleEndian<quint32>(quint32(blob.size()), entry + 4);
+        qToLittleEndian<quint32>(quint32(sections[i].size()), entry + 8);
+        blob += sections[i];
+    }
+    if (quint64(blob.size()) > 0xFFFFFFFFu) {
+        return fail("Compiled policy exceeds 4 GB");
+    }
+
+    uchar* header = reinterpret_cast<uchar*>(blob.data());
+    qToLittleEndian<quint32>(BlobMagic, header + MagicOffset);
+    qToLittleEndian<quint16>(FormatVersion, header + VersionOffset);
+    qToLittleEndian<quint16>(quint16(SectionCount), header + SectionCountOffset);
+    qToLittleEndian<quint64>(quint64(blob.size() - HeaderSize), header + PayloadSizeOffset);
+    const QByteArray checksum = Sha256::hash(QByteArrayView(blob).sliced(HeaderSize));
+    std::memcpy(header + ChecksumOffset, checksum.constData(), Sha256::DigestSize);
+    return blob;
+}
+
+bool PolicyBlob::isBlobData(QByteArrayView data) {
+    return data.size() >= 4
+        && qFromLittleEndian<quint32>(data.data() + MagicOffset) == BlobMagic;
+}
+
+std::shared_ptr<const PolicyBlob> PolicyBlob::open(const QString& path, QString* errorString) {
+    std::shared_ptr<PolicyBlob> blob(new PolicyBlob);
+    blob->m_file.setFileName(path);
+    if (!blob->m_file.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = QString("Failed to open compiled policy %1: %2").arg(path, blob->m_file.errorString());
+        }
+        return nullptr;
+    }
+
+    blob->m_size = blob->m_file.size();
+    if (blob->m_size < HeaderSize) {
+        if (errorString) {
+            *errorString = QString("Invalid compiled policy %1: Truncated file").arg(path);
+        }
+        return nullptr;
+    }
+    blob->m_data = blob->m_file.map(0, blob->m_size);
+    if (!blob->m_data) {
+        if (errorString) {
+            *errorString = QString("Failed to map compiled policy %1: %2").arg(path, blob->m_file.errorString());
+        }
+        return nullptr;
+    }
+
+    QString error;
+    if (!blob->parse(&error)) {
+        if (errorString) {
+            *errorString = QString("Invalid compiled policy %1: %2").arg(path, error);
+        }
+        return nullptr;
+    }
+    return blob;
+}
+
+bool PolicyBlob::parse(QString* errorString) {
+    auto fail = [errorString](const QString& message) {
+        *errorString = message;
+        return false;
+    };
+
+    if (!isLittleEndianHost()) {
+        return fail("Compiled policies are only supported on little-endian hosts");
+    }
+    if (!isBlobData(QByteArrayView(m_data, m_size))) {
+        return fail("Not a compiled policy");
+    }
+
+    const quint16 version = qFromLittleEndian<quint16>(m_data + VersionOffset);
+    if (version != FormatVersion) {
+        return fail(QString("Format version %1 is not supported (expected %2); recompile it with seb-policyc")
+                        .arg(version).arg(FormatVersion));
+    }
+
+    const quint64 payloadSize = qFromLittleEndian<quint64>(m_data + PayloadSizeOffset);
+    if (payloadSize != quint64(m_size - HeaderSize)) {
+        return fail("Truncated file");
+    }
+    const QByteArray checksum = Sha256::hash(QByteArrayView(m_data + HeaderSize, m_size - HeaderSize));
+    if (std::memcmp(checksum.constData(), m_data + ChecksumOffset, Sha256::DigestSize) != 0) {
+        return fail("Checksum mismatch");
+    }
+
+    // Locate the sections; the checksum already covers the table
+    const int sectionCount = qFromLittleEndian<quint16>(m_data + SectionCountOffset);
+    if (HeaderSize + qint64(sectionCount) * SectionEntrySize > m_size) {
+        return fail("Truncated section table");
+    }
+    QByteArrayView sections[HeaderDataSection + 1];
+    bool present[HeaderDataSection + 1] = {};
+    for (int i = 0; i < sectionCount; ++i) {
+        const uchar* entry = m_data + HeaderSize + i * SectionEntrySize;
+        const quint32 id = qFromLittleEndian<quint32>(entry);
+        const quint32 offset = qFromLittleEndian<quint32>(entry + 4);
+        const quint32 size = qFromLittleEndian<quint32>(entry + 8);
+        if (quint64(offset) + size > quint64(m_size)) {
+            return fail(QString("Section %1 is out of range").arg(id));
+        }
+        if (id <= HeaderDataSection) {
+            sections[id] = QByteArrayView(m_data + offset, size);
+            present[id] = true;
+        }
+    }
+    for (SectionId id : AllSections) {
+        if (!present[id]) {
+            return fail(QString("Section %1 is missing").arg(id));
+        }
+    }
+
+    // Policy fields are small; decode them into a regular Policy
+    {
+        const QByteArray data = QByteArray::fromRawData(sections[PolicySection].data(),
+                                                        sections[PolicySection].size());
+        QDataStream in(data);
+        in.setVersion(StreamVersion);
+        readPolicy(in, m_policy);
+        if (in.status() != QDataStream::Ok || !in.atEnd()) {
+            return fail("Corrupt policy section");
+        }
+    }
+
+    // Domain tables are used in place; validate them once
+    m_domainTables = DomainMatcher::Tables{
+        sections[DomainNodesSection], sections[DomainEdgesSection], sections[DomainLabelsSection]
+    };
+    QString tableError;
+    DomainMatcher::fromTables(m_domainTables, nullptr, &tableError);
+    if (!tableError.isEmpty()) {
+        return fail(tableError);
+    }
+
+    {
+        const QByteArray data = QByteArray::fromRawData(sections[UrlFilterSection].data(),
+                                                        sections[UrlFilterSection].size());
+        QDataStream in(data);
+        in.setVersion(StreamVersion);
+        in >> m_filterPattern >> m_filterGroupActions;
+        if (in.status() != QDataStream::Ok || !in.atEnd()) {
+            return fail("Corrupt URL filter section");
+        }
+    }
+
+    // Header values share the mapped bytes
+    const QByteArrayView index = sections[HeaderIndexSection];
+    const QByteArrayView headerData = sections[HeaderDataSection];
+    if (index.size() % 16 != 0) {
+        return fail("Corrupt header section");
+    }
+    auto slice = [&headerData](const char* entry, QByteArray& out) {
+        const quint32 offset = qFromLittleEndian<quint32>(entry);
+        const quint32 length = qFromLittleEndian<quint32>(entry + 4);
+        if (quint64(offset) + length > quint64(headerData.size())) {
+            return false;
+        }
+        out = QByteArray::fromRawData(headerData.data() + offset, length);
+        return true;
+    };
+    for (qsizetype i = 0; i < index.size(); i += 16) {
+        QPair<QByteArray, QByteArray> header;
+        if (!slice(index.data() + i, header.first) || !slice(index.data() + i + 8, header.second)) {
+            return fail("Corrupt header section");
+        }
+        m_headers.append(header);
+    }
+
+    return true;
+}
+
+DomainMatcher PolicyBlob::domainMatcher() const {
+    return DomainMatcher::fromTables(m_domainTables, shared_from_this());
+}
+
+UrlFilter PolicyBlob::urlFilter() const {
+    return UrlFilter(m_filterPattern, m_filterGroupActions);
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,79 @@
+#ifndef SEB_CORE_POLICY_BLOB_H
+#define SEB_CORE_POLICY_BLOB_H
+
+#include "Config.h"
+#include "DomainMatcher.h"
+#include "RequestHeaders.h"
+#include "UrlFilter.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+// Precompiled policy written by seb-policyc.
+//
+// A blob holds the validated Policy fields together with the tables that
+// are otherwise rebuilt at every start: the flattened domain trie, the
+// combined URL filter pattern with its group actions and the encoded
+// request headers. The file starts with a fixed header (magic "SEBP",
+// format version, byte order mark, payload size and the SHA-256 of the
+// payload), followed by a section table and 8-byte aligned sections. All
+// integers are little-endian.
+//
+// open() maps the file and verifies version and checksum; the domain tables
+// and header bytes are then used in place from the mapping. Install blobs
+// by renaming a new file over the old one (as seb-policyc does), never by
+// rewriting a mapped file in place.
+class PolicyBlob : public std::enable_shared_from_this<PolicyBlob> {
+public:
+    static constexpr quint16 FormatVersion = 3;
+
+    // Serialize a validated policy; empty with an error message on failure
+    static QByteArray compile(const Policy& policy, QString* errorString = nullptr);
+
+    static bool isBlobData(QByteArrayView data);
+
+    // Map and verify a compiled policy file; null with an error message on failure
+    static std::shared_ptr<const PolicyBlob> open(const QString& path, QString* errorString = nullptr);
+
+    PolicyBlob(const PolicyBlob&) = delete;
+    PolicyBlob& operator=(const PolicyBlob&) = delete;
+
+    // Decoded policy; Policy::compiled is left unset
+    const Policy& policy() const { return m_policy; }
+
+    // Matcher over the mapped tables; keeps the blob alive
+    DomainMatcher domainMatcher() const;
+    UrlFilter urlFilter() const;
+
+    // Header bytes point into the mapping; keep the blob alive while used
+    const HeaderList& headers() const { return m_headers; }
+
+    qint64 size() const { return m_size; }
+
+private:
+    PolicyBlob() = default;
+
+    bool parse(QString* errorString);
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+
+    Policy m_policy;
+    DomainMatcher::Tables m_domainTables;
+    QString m_filterPattern;
+    QList<int> m_filterGroupActions;
+    HeaderList m_headers;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_POLICY_BLOB_H
@@ -0,0 +1,45 @@
+#include "PolicySnapshot.h"
+#include "PolicyBlob.h"
+
+namespace seb {
+namespace core {
+
+PolicySnapshot::PolicySnapshot(const Policy& policy)
+    : m_policy(policy)
+    , m_domainMatcher(policy.compiled ? policy.compiled->domainMatcher() : DomainMatcher(policy.allowedDomains))
+    , m_urlFilter(policy.compiled ? policy.compiled->urlFilter() : UrlFilter(policy.urlFilterRules))
+    , m_resourceRules(policy.resourceRules, m_domainMatcher)
+    , m_verdictCache(HostVerdictCache::capacityForDomainCount(int(policy.allowedDomains.size())))
+{
+}
+
+bool PolicySnapshot::isUrlAllowed(const QUrl& url) const {
+    switch (m_urlFilter.evaluate(url)) {
+    case UrlFilter::Verdict::Allow:
+        return true;
+    case UrlFilter::Verdict::Block:
+        return false;
+    case UrlFilter::Verdict::NoMatch:
+        break;
+    }
+    return isHostAllowed(url.host(QUrl::FullyEncoded));
+}
+
+bool PolicySnapshot::isHostAllowed(const QString& host) const {
+    switch (m_verdictCache.lookup(host)) {
+    case HostVerdictCache::Verdict::Allowed:
+        return true;
+    case HostVerdictCache::Verdict::Blocked:
+        return false;
+    case HostVerdictCache::Verdict::Unknown:
+        break;
+    }
+
+    // Exact or subdomain match (e.g., "cdn.example.com" matches "example.com")
+    bool allowed = m_domainMatcher.matches(host);
+    m_verdictCache.store(host, allowed);
+    return allowed;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,49 @@
+#ifndef SEB_CORE_POLICY_SNAPSHOT_H
+#define SEB_CORE_POLICY_SNAPSHOT_H
+
+#include "Config.h"
+#include "DomainMatcher.h"
+#include "HostVerdictCache.h"
+#include "ResourceRuleTable.h"
+#include "UrlFilter.h"
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+namespace seb {
+namespace core {
+
+// Immutable, compiled form of a policy.
+//
+// Built once per (re)load, then shared read-only by the request interceptor
+// (IO thread) and the page (UI thread). Only the host verdict cache changes
+// after construction; it is lock-free and starts empty for every snapshot,
+// so verdicts never outlive the rules that produced them.
+class PolicySnapshot {
+public:
+    explicit PolicySnapshot(const Policy& policy);
+
+    PolicySnapshot(const PolicySnapshot&) = delete;
+    PolicySnapshot& operator=(const PolicySnapshot&) = delete;
+
+    const Policy& policy() const { return m_policy; }
+    const UrlFilter& urlFilter() const { return m_urlFilter; }
+    const ResourceRuleTable& resourceRules() const { return m_resourceRules; }
+    const HostVerdictCache& verdictCache() const { return m_verdictCache; }
+
+    // First matching URL filter rule, then the (cached) domain allowlist
+    bool isUrlAllowed(const QUrl& url) const;
+
+private:
+    bool isHostAllowed(const QString& host) const;
+
+    Policy m_policy;
+    DomainMatcher m_domainMatcher;
+    UrlFilter m_urlFilter;
+    ResourceRuleTable m_resourceRules;
+    mutable HostVerdictCache m_verdictCache;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_POLICY_SNAPSHOT_H
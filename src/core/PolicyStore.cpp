@@ -0,0 +1,81 @@
+#include "PolicyStore.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+namespace seb {
+namespace core {
+
+PolicyStore::Reader::Reader(Reader&& other) noexcept
+    : m_counter(other.m_counter)
+    , m_snapshot(other.m_snapshot)
+{
+    other.m_counter = nullptr;
+    other.m_snapshot = nullptr;
+}
+
+PolicyStore::Reader::~Reader() {
+    if (m_counter) {
+        m_counter->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+PolicyStore::PolicyStore(std::unique_ptr<const PolicySnapshot> initial)
+    : m_current(initial.release())
+    , m_epoch(0)
+    , m_retiredHits(0)
+    , m_retiredMisses(0)
+{
+    m_readers[0].store(0, std::memory_order_relaxed);
+    m_readers[1].store(0, std::memory_order_relaxed);
+}
+
+PolicyStore::~PolicyStore() {
+    delete m_current.load(std::memory_order_acquire);
+}
+
+PolicyStore::Reader PolicyStore::read() const {
+    for (;;) {
+        const quint64 epoch = m_epoch.load(std::memory_order_seq_cst);
+        std::atomic<int>* counter = &m_readers[epoch & 1];
+        counter->fetch_add(1, std::memory_order_seq_cst);
+
+        // A publish() between the two loads may already be draining this
+        // counter; register again under the new epoch
+        if (m_epoch.load(std::memory_order_seq_cst) == epoch) {
+            return Reader(counter, m_current.load(std::memory_order_seq_cst));
+        }
+        counter->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void PolicyStore::publish(std::unique_ptr<const PolicySnapshot> snapshot) {
+    QMutexLocker locker(&m_publishMutex);
+
+    // Release: readers that load the new pointer see the built snapshot
+    const PolicySnapshot* previous = m_current.exchange(snapshot.release(), std::memory_order_acq_rel);
+    const quint64 epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    // Readers registered under the old epoch may still use the previous
+    // snapshot; they only hold it for a single check. The counter load must
+    // be ordered after the epoch flip like the reader's registration is
+    // before its epoch check, otherwise a late reader could be missed.
+    std::atomic<int>& counter = m_readers[epoch & 1];
+    while (counter.load(std::memory_order_seq_cst) != 0) {
+        QThread::yieldCurrentThread();
+    }
+
+    m_retiredHits.fetch_add(previous->verdictCache().hits(), std::memory_order_relaxed);
+    m_retiredMisses.fetch_add(previous->verdictCache().misses(), std::memory_order_relaxed);
+    delete previous;
+}
+
+PolicyStore::CacheStats PolicyStore::verdictCacheStats() const {
+    const Reader snapshot = read();
+    return CacheStats{
+        m_retiredHits.load(std::memory_order_relaxed) + snapshot->verdictCache().hits(),
+        m_retiredMisses.load(std::memory_order_relaxed) + snapshot->verdictCache().misses()
+    };
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,80 @@
+#ifndef SEB_CORE_POLICY_STORE_H
+#define SEB_CORE_POLICY_STORE_H
+
+#include "PolicySnapshot.h"
+#include <QtCore/QMutex>
+#include <QtCore/QtGlobal>
+#include <atomic>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+// Holder of the current PolicySnapshot with RCU-style publication.
+//
+// Readers pin the current snapshot with read() and never lock: they bump one
+// of two reader counters (selected by the current epoch) and load the
+// snapshot pointer. publish() swaps the pointer, flips the epoch so new
+// readers use the other counter, waits for the old counter to drain and only
+// then deletes the previous snapshot. Readers therefore always see one
+// consistent snapshot for as long as they hold the Reader.
+//
+// Readers must be short-lived (one request or navigation check); publish()
+// waits for them and must not be called while holding a Reader.
+class PolicyStore {
+public:
+    class Reader {
+    public:
+        Reader(Reader&& other) noexcept;
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+
+        const PolicySnapshot* operator->() const { return m_snapshot; }
+        const PolicySnapshot& operator*() const { return *m_snapshot; }
+
+    private:
+        friend class PolicyStore;
+        Reader(std::atomic<int>* counter, const PolicySnapshot* snapshot)
+            : m_counter(counter), m_snapshot(snapshot) {}
+
+        std::atomic<int>* m_counter;
+        const PolicySnapshot* m_snapshot;
+    };
+
+    explicit PolicyStore(std::unique_ptr<const PolicySnapshot> initial);
+    ~PolicyStore();
+
+    PolicyStore(const PolicyStore&) = delete;
+    PolicyStore& operator=(const PolicyStore&) = delete;
+
+    Reader read() const;
+
+    // Replace the current snapshot; may be called from any thread
+    void publish(std::unique_ptr<const PolicySnapshot> snapshot);
+
+    // Number of snapshots published after the initial one
+    quint64 generation() const { return m_epoch.load(std::memory_order_acquire); }
+
+    // Host verdict cache statistics summed over all snapshots so far
+    struct CacheStats {
+        quint64 hits;
+        quint64 misses;
+    };
+    CacheStats verdictCacheStats() const;
+
+private:
+    std::atomic<const PolicySnapshot*> m_current;
+    std::atomic<quint64> m_epoch;
+    mutable std::atomic<int> m_readers[2];
+    QMutex m_publishMutex;
+    std::atomic<quint64> m_retiredHits;    // Of snapshots already replaced
+    std::atomic<quint64> m_retiredMisses;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_POLICY_STORE_H
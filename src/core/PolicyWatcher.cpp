@@ -0,0 +1,123 @@
+#include "PolicyWatcher.h"
+#include "ConfigLoader.h"
+#include "Logging.h"
+#include "PolicyStore.h"
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <memory>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+// Editors write in several steps; wait for the file to settle
+constexpr int DebounceMs = 300;
+
+} // namespace
+
+PolicyWatcher::PolicyWatcher(const QString& configPath, const Policy& basePolicy,
+                             QSharedPointer<PolicyStore> store, QObject* parent)
+    : QObject(parent)
+    , m_configPath(QFileInfo(configPath).absoluteFilePath())
+    , m_basePolicy(basePolicy)
+    , m_store(std::move(store))
+    , m_worker(new QObject)
+{
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DebounceMs);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &PolicyWatcher::reloadRequested);
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &PolicyWatcher::handleFileChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &PolicyWatcher::handleDirectoryChanged);
+
+    // Reloads run one at a time on the worker thread, in request order
+    m_thread.setObjectName("PolicyReload");
+    m_worker->moveToThread(&m_thread);
+    connect(this, &PolicyWatcher::reloadRequested, m_worker, [this]() { reload(); });
+}
+
+PolicyWatcher::~PolicyWatcher() {
+    m_thread.quit();
+    m_thread.wait();
+    delete m_worker;
+}
+
+void PolicyWatcher::start() {
+    m_watcher.addPath(QFileInfo(m_configPath).absolutePath());
+    watchFile();
+    m_thread.start(QThread::LowPriority);
+    qCDebug(lcConfig) << "Watching configuration for policy changes:" << m_configPath;
+}
+
+void PolicyWatcher::handleDirectoryChanged() {
+    // The file was replaced (rename over it) or recreated
+    if (!m_watcher.files().contains(m_configPath) && QFileInfo::exists(m_configPath)) {
+        watchFile();
+        m_debounceTimer.start();
+    }
+}
+
+void PolicyWatcher::handleFileChanged() {
+    // inotify drops the watch when the file is removed or replaced
+    if (!m_watcher.files().contains(m_configPath) && QFileInfo::exists(m_configPath)) {
+        watchFile();
+    }
+    m_debounceTimer.start();
+}
+
+void PolicyWatcher::watchFile() {
+    if (QFileInfo::exists(m_configPath)) {
+        m_watcher.addPath(m_configPath);
+    }
+}
+
+void PolicyWatcher::reload() {
+    // Worker thread: members used here are only written before start()
+    QElapsedTimer timer;
+    timer.start();
+
+    ConfigLoadResult result = ConfigLoader::loadFromFile(m_configPath);
+    if (!result.success) {
+        QMetaObject::invokeMethod(this, [this, error = result.errorMessage]() {
+            reportResult(error, 0);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    Policy policy = m_basePolicy;
+    policy.allowedDomains = result.policy.allowedDomains;
+    policy.urlFilterRules = result.policy.urlFilterRules;
+    policy.resourceRules = result.policy.resourceRules;
+    policy.compiled = result.policy.compiled;
+
+    auto snapshot = std::make_unique<const PolicySnapshot>(policy);
+    if (!snapshot->urlFilter().isValid()) {
+        QMetaObject::invokeMethod(this, [this, error = snapshot->urlFilter().errorString()]() {
+            reportResult(error, 0);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    m_store->publish(std::move(snapshot));
+    const quint64 generation = m_store->generation();
+    qCDebug(lcConfig) << "Policy snapshot" << generation << "built in" << timer.elapsed() << "ms";
+
+    QMetaObject::invokeMethod(this, [this, generation]() {
+        reportResult(QString(), generation);
+    }, Qt::QueuedConnection);
+}
+
+void PolicyWatcher::reportResult(const QString& errorMessage, quint64 generation) {
+    if (!errorMessage.isEmpty()) {
+        qCWarning(lcConfig) << "Policy reload failed, keeping current policy:" << errorMessage;
+        emit reloadFailed(errorMessage);
+        return;
+    }
+    qCDebug(lcConfig) << "Policy reloaded from" << m_configPath;
+    emit policyReloaded(generation);
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,65 @@
+#ifndef SEB_CORE_POLICY_WATCHER_H
+#define SEB_CORE_POLICY_WATCHER_H
+
+#include "Config.h"
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+namespace seb {
+namespace core {
+
+class PolicyStore;
+
+// Reloads the policy when the configuration file changes.
+//
+// The file and its directory are watched with QFileSystemWatcher (inotify on
+// Linux), so in-place writes as well as editors that replace the file are
+// seen. Changes are debounced, then the file is parsed and compiled into a
+// new PolicySnapshot on a dedicated thread and published to the store; the
+// UI thread only receives the result. Only the network policy
+// (allowedDomains, urlFilterRules) is taken from the new file: the start URL,
+// headers and keys stay as loaded at startup, since the exam server already
+// saw them. An invalid file leaves the current snapshot in place.
+class PolicyWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    PolicyWatcher(const QString& configPath, const Policy& basePolicy,
+                  QSharedPointer<PolicyStore> store, QObject* parent = nullptr);
+    ~PolicyWatcher() override;
+
+    void start();
+
+signals:
+    void policyReloaded(quint64 generation);
+    void reloadFailed(const QString& errorMessage);
+
+    // Internal: runs the reload on the worker thread
+    void reloadRequested();
+
+private slots:
+    void handleDirectoryChanged();
+    void handleFileChanged();
+
+private:
+    void watchFile();
+    void reload();
+    void reportResult(const QString& errorMessage, quint64 generation);
+
+    QString m_configPath;
+    Policy m_basePolicy;
+    QSharedPointer<PolicyStore> m_store;
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounceTimer;
+    QThread m_thread;
+    QObject* m_worker;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_POLICY_WATCHER_H
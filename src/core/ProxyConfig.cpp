@@ -0,0 +1,54 @@
+#include "ProxyConfig.h"
+#include "Logging.h"
+#include "ResourceProfile.h"
+#include <QtCore/QDebug>
+#include <QtNetwork/QNetworkProxyFactory>
+
+namespace seb {
+namespace core {
+
+QStringList ProxyConfig::bypassRules(const QString& host) {
+    // Wildcards, <local> and IP ranges are already in Chromium's syntax
+    if (host.contains('*') || host.startsWith('<') || host.contains('/') || host.contains(':')
+        || host.back().isDigit()) {
+        return {host};
+    }
+    return {host, "*." + host};
+}
+
+QStringList ProxyConfig::chromiumFlags(const ProxySettings& settings) {
+    QStringList flags;
+    if (settings.mode == "direct") {
+        flags << "--no-proxy-server";
+    } else if (settings.mode == "fixed") {
+        flags << "--proxy-server=" + settings.server;
+        QStringList bypass;
+        for (const QString& host : settings.bypass) {
+            bypass << bypassRules(host);
+        }
+        if (!bypass.isEmpty()) {
+            flags << "--proxy-bypass-list=" + bypass.join(';');
+        }
+    } else if (settings.mode == "pac") {
+        flags << "--proxy-pac-url=" + settings.pacUrl;
+    }
+    return flags;
+}
+
+void ProxyConfig::apply(const ProxySettings& settings) {
+    if (settings.mode == "fixed") {
+        qCInfo(lcProxy) << "Proxy server:" << settings.server << "bypass:" << settings.bypass;
+    } else if (settings.mode == "pac") {
+        qCInfo(lcProxy) << "Proxy auto-config:" << settings.pacUrl.left(120);
+    } else {
+        qCDebug(lcProxy) << "Proxy mode:" << settings.mode;
+    }
+    // Without this QtWebEngine only sees the application proxy (none)
+    if (settings.mode == "system") {
+        QNetworkProxyFactory::setUseSystemConfiguration(true);
+    }
+    ResourceProfile::exportChromiumFlags(chromiumFlags(settings));
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,33 @@
+#ifndef SEB_CORE_PROXY_CONFIG_H
+#define SEB_CORE_PROXY_CONFIG_H
+
+#include "Config.h"
+#include <QtCore/QStringList>
+
+namespace seb {
+namespace core {
+
+// Translates ProxySettings into Chromium switches.
+//
+// QtWebEngine takes its proxy from these switches when one is given.
+// Otherwise it uses QNetworkProxy::applicationProxy, and the system
+// settings (proxy environment variables, desktop settings) only once
+// QNetworkProxyFactory::setUseSystemConfiguration(true) was called, which
+// apply() does for mode "system".
+class ProxyConfig {
+public:
+    static QStringList chromiumFlags(const ProxySettings& settings);
+
+    // Export the switches through QTWEBENGINE_CHROMIUM_FLAGS and, for mode
+    // "system", turn on the system proxy configuration; must run before
+    // QtWebEngine creates its first profile
+    static void apply(const ProxySettings& settings);
+
+    // Chromium bypass list entries for a host and its subdomains
+    static QStringList bypassRules(const QString& host);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_PROXY_CONFIG_H
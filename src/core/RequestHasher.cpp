@@ -0,0 +1,51 @@
+#include "RequestHasher.h"
+#include "Sha256.h"
+#include <QtCore/QMutexLocker>
+
+namespace seb {
+namespace core {
+
+RequestHasher::RequestHasher(const QString& browserExamKey, const QString& configKey, int memoCapacity)
+    : m_browserExamKey(browserExamKey.toUtf8())
+    , m_configKey(configKey.toUtf8())
+    , m_memo(memoCapacity)
+{
+}
+
+RequestHasher::Hashes RequestHasher::hashesFor(const QByteArray& url) {
+    if (!isEnabled()) {
+        return Hashes();
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const Hashes* cached = m_memo.object(url)) {
+            return *cached;
+        }
+    }
+
+    // Hash outside the lock; a concurrent miss on the same URL just
+    // computes the same value twice
+    Hashes* hashes = new Hashes;
+    if (!m_browserExamKey.isEmpty()) {
+        hashes->requestHash = computeHash(url, m_browserExamKey);
+    }
+    if (!m_configKey.isEmpty()) {
+        hashes->configKeyHash = computeHash(url, m_configKey);
+    }
+
+    Hashes result = *hashes;
+    QMutexLocker locker(&m_mutex);
+    m_memo.insert(url, hashes);
+    return result;
+}
+
+QByteArray RequestHasher::computeHash(const QByteArray& url, const QByteArray& key) {
+    Sha256 sha;
+    sha.addData(url);
+    sha.addData(key);
+    return sha.result().toHex();
+}
+
+} // namespace core
+} // namespace seb
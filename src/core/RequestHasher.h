@@ -0,0 +1,43 @@
+#ifndef SEB_CORE_REQUEST_HASHER_H
+#define SEB_CORE_REQUEST_HASHER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+namespace seb {
+namespace core {
+
+// Computes the per-request SEB verification hashes:
+//   X-SafeExamBrowser-RequestHash   = hex(SHA-256(url + browser exam key))
+//   X-SafeExamBrowser-ConfigKeyHash = hex(SHA-256(url + config key))
+// where url is the absolute request URL without fragment. Results are
+// memoized per URL, since pages request the same resources repeatedly.
+class RequestHasher {
+public:
+    struct Hashes {
+        QByteArray requestHash;     // Empty if no browser exam key is set
+        QByteArray configKeyHash;   // Empty if no config key is set
+    };
+
+    RequestHasher(const QString& browserExamKey, const QString& configKey, int memoCapacity = 512);
+
+    bool isEnabled() const { return !m_browserExamKey.isEmpty() || !m_configKey.isEmpty(); }
+
+    // Thread-safe; url must already be encoded and stripped of its fragment
+    Hashes hashesFor(const QByteArray& url);
+
+    static QByteArray computeHash(const QByteArray& url, const QByteArray& key);
+
+private:
+    QByteArray m_browserExamKey;
+    QByteArray m_configKey;
+    QMutex m_mutex;
+    QCache<QByteArray, Hashes> m_memo;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_REQUEST_HASHER_H
@@ -0,0 +1,19 @@
+#include "RequestHeaders.h"
+
+namespace seb {
+namespace core {
+
+HeaderList RequestHeaders::encode(const Policy& policy) {
+    HeaderList headers;
+    headers.append({QByteArrayLiteral("X-SafeExamBrowser"), QByteArrayLiteral("SEB-Linux-MVP")});
+
+    // SEB standard headers (with values from config or defaults)
+    headers.append({QByteArrayLiteral("X-SafeExamBrowser-ClientVersion"), policy.getClientVersion().toUtf8()});
+    headers.append({QByteArrayLiteral("X-SafeExamBrowser-ClientType"), policy.getClientType().toUtf8()});
+    headers.append({QByteArrayLiteral("X-SafeExamBrowser-ConfigVersion"), QByteArrayLiteral("2")});
+
+    return headers;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,24 @@
+#ifndef SEB_CORE_REQUEST_HEADERS_H
+#define SEB_CORE_REQUEST_HEADERS_H
+
+#include "Config.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+
+namespace seb {
+namespace core {
+
+using HeaderList = QList<QPair<QByteArray, QByteArray>>;
+
+// Static SEB headers sent with every request. Encoded once per policy (or
+// ahead of time by seb-policyc) so requests only share the buffers.
+class RequestHeaders {
+public:
+    static HeaderList encode(const Policy& policy);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_REQUEST_HEADERS_H
@@ -0,0 +1,182 @@
+#include "ResourceProfile.h"
+#include "Logging.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <algorithm>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+QMutex lastSampleMutex;
+QList<ResourceProfile::ProcessMemory> lastSample;
+
+QByteArray readProcFile(qint64 pid, const char* name) {
+    // /proc files report size 0, so read until EOF
+    QFile file(QString("/proc/%1/%2").arg(pid).arg(QLatin1String(name)));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+// Field 4 of /proc/<pid>/stat; the command name before it may contain
+// spaces and parentheses, so parse from the last ')'
+qint64 parentPid(qint64 pid) {
+    const QByteArray stat = readProcFile(pid, "stat");
+    const qsizetype end = stat.lastIndexOf(')');
+    if (end < 0) {
+        return -1;
+    }
+    const QList<QByteArray> fields = stat.mid(end + 2).split(' ');
+    return fields.size() > 1 ? fields[1].toLongLong() : -1;
+}
+
+// Value in kB of a "Name:   1234 kB" line; name includes the colon
+qint64 kilobytesField(const QByteArray& text, const QByteArray& name) {
+    qsizetype at = text.startsWith(name) ? 0 : text.indexOf('\n' + name);
+    if (at < 0) {
+        return 0;
+    }
+    at = text.indexOf(':', at) + 1;
+    const qsizetype end = text.indexOf('\n', at);
+    return text.mid(at, end < 0 ? -1 : end - at).trimmed().split(' ').first().toLongLong();
+}
+
+QString processType(qint64 pid) {
+    const QByteArray cmdline = readProcFile(pid, "cmdline");
+    for (const QByteArray& arg : cmdline.split('\0')) {
+        if (arg.startsWith("--type=")) {
+            return QString::fromLatin1(arg.mid(7));
+        }
+    }
+    return QString("browser");
+}
+
+} // namespace
+
+QStringList ResourceProfile::chromiumFlags(const ResourceSettings& settings) {
+    QStringList flags;
+    if (settings.processModel == "process-per-site") {
+        flags << "--process-per-site";
+    }
+    if (settings.rendererProcessLimit > 0) {
+        flags << QString("--renderer-process-limit=%1").arg(settings.rendererProcessLimit);
+    }
+    if (settings.jsHeapLimitMb > 0) {
+        flags << QString("--js-flags=--max-old-space-size=%1").arg(settings.jsHeapLimitMb);
+    }
+    if (!settings.disabledFeatures.isEmpty()) {
+        flags << "--disable-features=" + settings.disabledFeatures.join(',');
+    }
+    if (settings.disableBackgroundNetworking) {
+        flags << "--disable-background-networking" << "--disable-component-update";
+    }
+    return flags;
+}
+
+void ResourceProfile::apply(const ResourceSettings& settings) {
+    exportChromiumFlags(chromiumFlags(settings));
+}
+
+void ResourceProfile::exportChromiumFlags(const QStringList& flags) {
+    if (flags.isEmpty()) {
+        return;
+    }
+
+    QByteArray value = flags.join(' ').toLatin1();
+    const QByteArray existing = qgetenv("QTWEBENGINE_CHROMIUM_FLAGS");
+    if (!existing.isEmpty()) {
+        value += ' ' + existing;
+    }
+    qputenv("QTWEBENGINE_CHROMIUM_FLAGS", value);
+    qCDebug(lcResources) << "Chromium flags:" << value;
+}
+
+QList<ResourceProfile::ProcessMemory> ResourceProfile::processMemory() {
+    const qint64 self = QCoreApplication::applicationPid();
+
+    // Parent links of every process, then walk down from this one
+    QHash<qint64, qint64> parents;
+    const QStringList entries = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& entry : entries) {
+        bool ok = false;
+        const qint64 pid = entry.toLongLong(&ok);
+        if (ok) {
+            parents.insert(pid, parentPid(pid));
+        }
+    }
+
+    QSet<qint64> tree{self};
+    bool grew = true;
+    while (grew) {
+        grew = false;
+        for (auto it = parents.cbegin(); it != parents.cend(); ++it) {
+            if (!tree.contains(it.key()) && tree.contains(it.value())) {
+                tree.insert(it.key());
+                grew = true;
+            }
+        }
+    }
+
+    QList<ProcessMemory> processes;
+    for (qint64 pid : std::as_const(tree)) {
+        const QByteArray status = readProcFile(pid, "status");
+        if (status.isEmpty()) {
+            continue; // Exited meanwhile
+        }
+        ProcessMemory process;
+        process.pid = pid;
+        process.type = pid == self ? QString("browser") : processType(pid);
+        process.residentKb = kilobytesField(status, "VmRSS:");
+        process.proportionalKb = kilobytesField(readProcFile(pid, "smaps_rollup"), "Pss:");
+        processes.append(process);
+    }
+
+    std::sort(processes.begin(), processes.end(), [](const ProcessMemory& a, const ProcessMemory& b) {
+        return a.residentKb > b.residentKb;
+    });
+    return processes;
+}
+
+QString ResourceProfile::memoryReport() {
+    const QList<ProcessMemory> processes = processMemory();
+    {
+        QMutexLocker locker(&lastSampleMutex);
+        lastSample = processes;
+    }
+
+    qint64 totalRss = 0;
+    qint64 totalPss = 0;
+    QString lines;
+    for (const ProcessMemory& process : processes) {
+        totalRss += process.residentKb;
+        totalPss += process.proportionalKb;
+        lines += QString("\n  %1 %2 rss %3 MB pss %4 MB")
+                     .arg(process.pid, 7)
+                     .arg(process.type, -12)
+                     .arg(process.residentKb / 1024.0, 0, 'f', 1)
+                     .arg(process.proportionalKb / 1024.0, 0, 'f', 1);
+    }
+
+    return QString("Resident memory: %1 processes, rss %2 MB, pss %3 MB")
+               .arg(processes.size())
+               .arg(totalRss / 1024.0, 0, 'f', 1)
+               .arg(totalPss / 1024.0, 0, 'f', 1)
+           + lines;
+}
+
+QList<ResourceProfile::ProcessMemory> ResourceProfile::lastProcessMemory() {
+    QMutexLocker locker(&lastSampleMutex);
+    return lastSample;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,47 @@
+#ifndef SEB_CORE_RESOURCE_PROFILE_H
+#define SEB_CORE_RESOURCE_PROFILE_H
+
+#include "Config.h"
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace seb {
+namespace core {
+
+// Translates ResourceSettings into Chromium switches and reports the memory
+// used by the browser and its WebEngine helper processes.
+class ResourceProfile {
+public:
+    struct ProcessMemory {
+        qint64 pid = 0;
+        QString type;              // "browser", "renderer", "gpu-process", "utility", "zygote", ...
+        qint64 residentKb = 0;     // VmRSS
+        qint64 proportionalKb = 0; // Pss, shared pages split between processes (0 if unknown)
+    };
+
+    static QStringList chromiumFlags(const ResourceSettings& settings);
+
+    // Export the switches through QTWEBENGINE_CHROMIUM_FLAGS. Must run before
+    // QApplication is created; flags already in the environment come last so
+    // a manual override still wins.
+    static void apply(const ResourceSettings& settings);
+
+    // Prepend switches to QTWEBENGINE_CHROMIUM_FLAGS (shared with the proxy
+    // settings); switches must not contain spaces
+    static void exportChromiumFlags(const QStringList& flags);
+
+    // This process and all of its descendants (Linux /proc)
+    static QList<ProcessMemory> processMemory();
+
+    // Multi-line summary of processMemory(), largest processes first
+    static QString memoryReport();
+
+    // Processes sampled by the latest memoryReport(); empty before the first
+    static QList<ProcessMemory> lastProcessMemory();
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_RESOURCE_PROFILE_H
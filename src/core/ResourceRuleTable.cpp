@@ -0,0 +1,83 @@
+#include "ResourceRuleTable.h"
+
+namespace seb {
+namespace core {
+
+namespace {
+
+bool isSameOrSubdomain(QStringView host, QStringView domain) {
+    if (host.size() == domain.size()) {
+        return host.compare(domain, Qt::CaseInsensitive) == 0;
+    }
+    return host.size() > domain.size()
+        && host[host.size() - domain.size() - 1] == u'.'
+        && host.endsWith(domain, Qt::CaseInsensitive);
+}
+
+} // namespace
+
+ResourceRuleTable::ResourceRuleTable(const QList<ResourceRule>& rules, const DomainMatcher& sites)
+    : m_sites(sites)
+{
+    // Rules share one matcher however many types they name
+    QList<int> matcherForRule;
+    for (const ResourceRule& rule : rules) {
+        if (rule.domains.isEmpty()) {
+            matcherForRule.append(-1);
+        } else {
+            matcherForRule.append(int(m_matchers.size()));
+            m_matchers.append(DomainMatcher(rule.domains));
+        }
+    }
+
+    for (int slot = 0; slot < ResourceType::SlotCount; ++slot) {
+        Range& range = m_ranges[slot];
+        range.first = int(m_entries.size());
+        for (qsizetype i = 0; i < rules.size(); ++i) {
+            const ResourceRule& rule = rules[i];
+            bool named = false;
+            for (const QString& type : rule.types) {
+                named = named || ResourceType::slotFromName(type) == slot;
+            }
+            if (!named) {
+                continue;
+            }
+            m_entries.append({rule.action == ResourceRule::Action::Allow, rule.thirdPartyOnly, matcherForRule[i]});
+            if (matcherForRule[i] < 0 && !rule.thirdPartyOnly) {
+                break;
+            }
+        }
+        range.count = int(m_entries.size()) - range.first;
+    }
+}
+
+ResourceRuleTable::Verdict ResourceRuleTable::evaluate(int resourceType, QStringView host,
+                                                       QStringView firstPartyHost) const {
+    const Range& range = m_ranges[ResourceType::slot(resourceType)];
+    for (int i = range.first; i < range.first + range.count; ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.thirdPartyOnly && !isThirdParty(host, firstPartyHost)) {
+            continue;
+        }
+        if (entry.matcher >= 0 && !m_matchers[entry.matcher].matches(host)) {
+            continue;
+        }
+        return entry.allow ? Verdict::Allow : Verdict::Block;
+    }
+    return Verdict::NoMatch;
+}
+
+bool ResourceRuleTable::isThirdParty(QStringView host, QStringView firstPartyHost) const {
+    // Requests without a page (service workers, prefetch) are not attributed
+    if (firstPartyHost.isEmpty()) {
+        return false;
+    }
+    QStringView site = m_sites.matchedDomain(firstPartyHost);
+    if (site.isEmpty()) {
+        site = firstPartyHost;
+    }
+    return !isSameOrSubdomain(host, site);
+}
+
+} // namespace core
+} // namespace seb
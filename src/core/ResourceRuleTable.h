@@ -0,0 +1,68 @@
+#ifndef SEB_CORE_RESOURCE_RULE_TABLE_H
+#define SEB_CORE_RESOURCE_RULE_TABLE_H
+
+#include "Config.h"
+#include "DomainMatcher.h"
+#include "ResourceType.h"
+#include <QtCore/QList>
+#include <QtCore/QStringView>
+#include <array>
+
+namespace seb {
+namespace core {
+
+// Resource rules precomputed per resource type.
+//
+// Every rule is expanded into the slots of the types it names, keeping
+// config order, and each slot's list ends at its first unconditional rule
+// (no domains, not third-party only) since nothing after it can match.
+// A lookup indexes the slot directly and only walks the rules written for
+// that type; a type without rules costs one array access.
+class ResourceRuleTable {
+public:
+    enum class Verdict {
+        NoMatch,
+        Allow,
+        Block
+    };
+
+    ResourceRuleTable() = default;
+    // `sites` is the domain allowlist; it decides which hosts are third-party
+    explicit ResourceRuleTable(const QList<ResourceRule>& rules, const DomainMatcher& sites = DomainMatcher());
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+    // First matching rule for a request of `resourceType` (as numbered by
+    // QWebEngineUrlRequestInfo) to `host`, issued by a page on `firstPartyHost`
+    Verdict evaluate(int resourceType, QStringView host, QStringView firstPartyHost) const;
+
+    // Whether `host` belongs to a different site than `firstPartyHost`. The
+    // page's site is the broadest allowed domain it is under (with "uni.edu"
+    // allowed, cdn.uni.edu is same-site to lms.uni.edu), or just the page
+    // host and its subdomains if the allowlist does not cover it. Using the
+    // allowlist instead of guessing the registrable domain keeps country
+    // code suffixes (co.uk, edu.au) from becoming a site of their own.
+    bool isThirdParty(QStringView host, QStringView firstPartyHost) const;
+
+private:
+    struct Entry {
+        bool allow;
+        bool thirdPartyOnly;
+        int matcher;               // Index into m_matchers, -1: any host
+    };
+
+    struct Range {
+        int first = 0;
+        int count = 0;
+    };
+
+    std::array<Range, ResourceType::SlotCount> m_ranges{};
+    QList<Entry> m_entries;        // Grouped by slot
+    QList<DomainMatcher> m_matchers;
+    DomainMatcher m_sites;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_RESOURCE_RULE_TABLE_H
@@ -0,0 +1,41 @@
+#include "ResourceType.h"
+#include <QtCore/QString>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+const char* const SlotNames[ResourceType::SlotCount] = {
+    "main_frame", "sub_frame", "stylesheet", "script", "image", "font", "sub_resource",
+    "object", "media", "worker", "shared_worker", "prefetch", "favicon", "xhr", "ping",
+    "service_worker", "csp_report", "plugin_resource", "other", "navigation_preload_main_frame",
+    "navigation_preload_sub_frame", "websocket", "unknown"
+};
+
+constexpr int WebSocketSlot = ResourceType::UnknownSlot - 1;
+
+} // namespace
+
+int ResourceType::slot(int resourceType) {
+    if (resourceType >= 0 && resourceType < WebSocketSlot) {
+        return resourceType;
+    }
+    return resourceType == WebSocket ? WebSocketSlot : UnknownSlot;
+}
+
+const char* ResourceType::name(int slot) {
+    return SlotNames[slot >= 0 && slot < SlotCount ? slot : UnknownSlot];
+}
+
+int ResourceType::slotFromName(QStringView name) {
+    for (int slot = 0; slot < SlotCount; ++slot) {
+        if (name == QLatin1String(SlotNames[slot])) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+} // namespace core
+} // namespace seb
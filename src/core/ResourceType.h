@@ -0,0 +1,36 @@
+#ifndef SEB_CORE_RESOURCE_TYPE_H
+#define SEB_CORE_RESOURCE_TYPE_H
+
+#include <QtCore/QStringView>
+
+namespace seb {
+namespace core {
+
+// Dense slots for QWebEngineUrlRequestInfo::ResourceType.
+//
+// The enum is contiguous from 0 up to the navigation preload types, with
+// WebSocket at 254; slots keep that numbering, put WebSocket right after
+// and map anything newer to a final "unknown" slot, so per-type tables can
+// be plain arrays indexed in O(1).
+class ResourceType {
+public:
+    static constexpr int MainFrame = 0;
+    static constexpr int WebSocket = 254;
+
+    // Contiguous types, plus websocket and unknown
+    static constexpr int SlotCount = 23;
+    static constexpr int UnknownSlot = SlotCount - 1;
+
+    static int slot(int resourceType);
+
+    // Snake case name of a slot ("main_frame", "xhr", ...)
+    static const char* name(int slot);
+
+    // Slot for a name as returned by name(); -1 if unknown
+    static int slotFromName(QStringView name);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_RESOURCE_TYPE_H
@@ -0,0 +1,415 @@
+#include "SebFileReader.h"
+#include <QtCore/QBuffer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QXmlStreamReader>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+namespace seb {
+namespace core {
+
+namespace {
+
+using ChunkSink = std::function<bool(const char* data, size_t size)>;
+
+constexpr size_t InputSliceSize = 1024 * 1024;
+// Configurations are a few MB at most; stops gzip bombs early
+constexpr size_t MaxInflatedSize = 64 * 1024 * 1024;
+constexpr int MaxPlistDepth = 128;
+
+bool hasGzipMagic(QByteArrayView data) {
+    return data.size() >= 2 && uchar(data[0]) == 0x1f && uchar(data[1]) == 0x8b;
+}
+
+// Incremental gzip decoder handing out fixed-size output chunks
+class GzipStream {
+public:
+    GzipStream() {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        m_stream.next_in = Z_NULL;
+        m_stream.avail_in = 0;
+        // 16 + MAX_WBITS: expect a gzip header
+        m_initialized = inflateInit2(&m_stream, 16 + MAX_WBITS) == Z_OK;
+    }
+
+    ~GzipStream() {
+        if (m_initialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    GzipStream(const GzipStream&) = delete;
+    GzipStream& operator=(const GzipStream&) = delete;
+
+    bool feed(const char* data, size_t size, const ChunkSink& sink) {
+        if (!m_initialized) {
+            m_error = "Failed to initialize gzip decoder";
+            return false;
+        }
+
+        while (size > 0 && !m_finished) {
+            size_t slice = qMin(size, InputSliceSize);
+            m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            m_stream.avail_in = uInt(slice);
+            data += slice;
+            size -= slice;
+
+            while (!m_finished) {
+                m_stream.next_out = reinterpret_cast<Bytef*>(m_buffer);
+                m_stream.avail_out = uInt(sizeof(m_buffer));
+
+                int ret = inflate(&m_stream, Z_NO_FLUSH);
+                if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                    m_error = QString("Decompression failed: %1")
+                                  .arg(m_stream.msg ? QString::fromLatin1(m_stream.msg) : QString::number(ret));
+                    return false;
+                }
+
+                size_t produced = sizeof(m_buffer) - m_stream.avail_out;
+                m_total += produced;
+                if (m_total > MaxInflatedSize) {
+                    m_error = QString("Decompressed data exceeds %1 MB").arg(MaxInflatedSize / (1024 * 1024));
+                    return false;
+                }
+                if (produced > 0 && !sink(m_buffer, produced)) {
+                    return false;
+                }
+
+                if (ret == Z_STREAM_END) {
+                    m_finished = true;
+                } else if (m_stream.avail_out != 0) {
+                    break; // Needs more input
+                }
+            }
+        }
+        return true;
+    }
+
+    bool isFinished() const { return m_finished; }
+    QString errorString() const { return m_error; }
+
+private:
+    z_stream m_stream;
+    bool m_initialized = false;
+    bool m_finished = false;
+    size_t m_total = 0;
+    QString m_error;
+    char m_buffer[64 * 1024];
+};
+
+// Builds JSON values from an XML plist fed in arbitrary chunks
+class PlistParser {
+public:
+    bool feed(const char* data, size_t size) {
+        m_xml.addData(QByteArray(data, qsizetype(size)));
+        return pump();
+    }
+
+    // Parse a complete document in place: the reader pulls small blocks
+    // through a buffer device instead of copying the whole document
+    bool parse(QByteArrayView document) {
+        m_document = QByteArray::fromRawData(document.data(), document.size());
+        m_device.setBuffer(&m_document);
+        m_device.open(QIODevice::ReadOnly);
+        m_xml.setDevice(&m_device);
+        return pump();
+    }
+
+    bool finish() {
+        if (!m_error.isEmpty()) {
+            return false;
+        }
+        if (!m_done) {
+            m_error = m_xml.hasError()
+                ? QString("Plist parse error at line %1: %2").arg(m_xml.lineNumber()).arg(m_xml.errorString())
+                : QString("Incomplete plist document");
+            return false;
+        }
+        return true;
+    }
+
+    QJsonValue root() const { return m_root; }
+    QString errorString() const { return m_error; }
+
+private:
+    struct Frame {
+        bool isDict = false;
+        QJsonObject object;
+        QJsonArray array;
+        QString key;
+        bool hasKey = false;
+    };
+
+    bool pump() {
+        while (!m_xml.atEnd()) {
+            switch (m_xml.readNext()) {
+            case QXmlStreamReader::StartElement:
+                handleStart(m_xml.name());
+                break;
+            case QXmlStreamReader::EndElement:
+                handleEnd(m_xml.name());
+                break;
+            case QXmlStreamReader::Characters:
+                if (m_collecting) {
+                    m_text += m_xml.text();
+                }
+                break;
+            default:
+                break;
+            }
+            if (!m_error.isEmpty()) {
+                return false;
+            }
+        }
+
+        // Running out of input mid-document just means more chunks follow
+        if (m_xml.hasError() && m_xml.error() != QXmlStreamReader::PrematureEndOfDocumentError) {
+            m_error = QString("Plist parse error at line %1: %2")
+                          .arg(m_xml.lineNumber())
+                          .arg(m_xml.errorString());
+            return false;
+        }
+        return true;
+    }
+
+    void handleStart(QStringView name) {
+        if (name == u"plist" || name == u"true" || name == u"false") {
+            return;
+        }
+        if (name == u"dict" || name == u"array") {
+            if (int(m_stack.size()) >= MaxPlistDepth) {
+                m_error = "Plist nesting too deep";
+                return;
+            }
+            Frame frame;
+            frame.isDict = name == u"dict";
+            m_stack.push_back(std::move(frame));
+            return;
+        }
+        if (name == u"key" || name == u"string" || name == u"integer" || name == u"real"
+            || name == u"data" || name == u"date") {
+            m_collecting = true;
+            m_text.clear();
+            return;
+        }
+        m_error = QString("Unexpected plist element: %1").arg(name);
+    }
+
+    void handleEnd(QStringView name) {
+        if (name == u"plist") {
+            m_done = true;
+        } else if (name == u"dict" || name == u"array") {
+            Frame frame = std::move(m_stack.back());
+            m_stack.pop_back();
+            attach(frame.isDict ? QJsonValue(frame.object) : QJsonValue(frame.array));
+        } else if (name == u"key") {
+            m_collecting = false;
+            if (m_stack.empty() || !m_stack.back().isDict) {
+                m_error = "Plist <key> outside of <dict>";
+                return;
+            }
+            m_stack.back().key = m_text;
+            m_stack.back().hasKey = true;
+        } else if (name == u"string" || name == u"date") {
+            attach(m_text);
+        } else if (name == u"integer") {
+            bool ok = false;
+            qlonglong value = m_text.trimmed().toLongLong(&ok);
+            if (!ok) {
+                m_error = QString("Invalid plist integer: %1").arg(m_text);
+                return;
+            }
+            attach(double(value));
+        } else if (name == u"real") {
+            bool ok = false;
+            double value = m_text.trimmed().toDouble(&ok);
+            if (!ok) {
+                m_error = QString("Invalid plist real: %1").arg(m_text);
+                return;
+            }
+            attach(value);
+        } else if (name == u"data") {
+            // Keep base64 as-is, only drop the line breaks/indentation
+            QString base64;
+            base64.reserve(m_text.size());
+            for (QChar c : std::as_const(m_text)) {
+                if (!c.isSpace()) {
+                    base64.append(c);
+                }
+            }
+            attach(base64);
+        } else if (name == u"true") {
+            attach(true);
+        } else if (name == u"false") {
+            attach(false);
+        }
+    }
+
+    void attach(const QJsonValue& value) {
+        m_collecting = false;
+        if (m_stack.empty()) {
+            m_root = value;
+            return;
+        }
+
+        Frame& top = m_stack.back();
+        if (!top.isDict) {
+            top.array.append(value);
+            return;
+        }
+        if (!top.hasKey) {
+            m_error = "Plist <dict> value without <key>";
+            return;
+        }
+        top.object.insert(top.key, value);
+        top.hasKey = false;
+    }
+
+    QByteArray m_document;
+    QBuffer m_device;
+    QXmlStreamReader m_xml;
+    std::vector<Frame> m_stack;
+    QJsonValue m_root;
+    QString m_text;
+    QString m_error;
+    bool m_collecting = false;
+    bool m_done = false;
+};
+
+} // namespace
+
+bool SebFileReader::isSebData(QByteArrayView data) {
+    if (hasGzipMagic(data) || data.startsWith("plnd")) {
+        return true;
+    }
+
+    // Uncompressed XML plist, possibly after a BOM and whitespace
+    if (data.startsWith("\xEF\xBB\xBF")) {
+        data = data.sliced(3);
+    }
+    while (!data.isEmpty() && (data[0] == ' ' || data[0] == '\t' || data[0] == '\r' || data[0] == '\n')) {
+        data = data.sliced(1);
+    }
+    return data.startsWith("<?xml") || data.startsWith("<!DOCTYPE plist") || data.startsWith("<plist");
+}
+
+SebFileResult SebFileReader::read(QByteArrayView data) {
+    PlistParser plist;
+    GzipStream inner;
+    QString error;
+
+    enum class Payload {
+        Unknown,
+        Plain,
+        Compressed
+    };
+    Payload payload = Payload::Unknown;
+
+    // Classify the payload by its first four bytes; returns how many of
+    // them belong to the "plnd" prefix, or -1 on error
+    auto classify = [&](QByteArrayView prefix) {
+        if (prefix.startsWith("plnd")) {
+            payload = Payload::Compressed;
+            return 4;
+        }
+        if (prefix.startsWith("pswd") || prefix.startsWith("pwcc")
+            || prefix.startsWith("pkhs") || prefix.startsWith("phsk")) {
+            error = QString("Encrypted .seb files are not supported (format '%1')")
+                        .arg(QString::fromLatin1(prefix.data(), prefix.size()));
+            return -1;
+        }
+        payload = hasGzipMagic(prefix) ? Payload::Compressed : Payload::Plain;
+        return 0;
+    };
+
+    const ChunkSink xmlSink = [&](const char* chunk, size_t size) {
+        return plist.feed(chunk, size);
+    };
+
+    const ChunkSink forward = [&](const char* chunk, size_t size) {
+        if (payload == Payload::Compressed) {
+            return inner.feed(chunk, size, xmlSink);
+        }
+        return plist.feed(chunk, size);
+    };
+
+    // Only a prefix split across inflated chunks is copied (at most 4 bytes)
+    char head[4];
+    size_t headSize = 0;
+    auto decide = [&]() {
+        const int consumed = classify(QByteArrayView(head, qsizetype(headSize)));
+        if (consumed < 0) {
+            return false;
+        }
+        return headSize == size_t(consumed) || forward(head + consumed, headSize - size_t(consumed));
+    };
+
+    const ChunkSink payloadSink = [&](const char* chunk, size_t size) {
+        if (payload == Payload::Unknown) {
+            const size_t take = qMin(size, sizeof(head) - headSize);
+            std::memcpy(head + headSize, chunk, take);
+            headSize += take;
+            chunk += take;
+            size -= take;
+            if (headSize < sizeof(head)) {
+                return true;
+            }
+            if (!decide()) {
+                return false;
+            }
+        }
+        return size == 0 || forward(chunk, size);
+    };
+
+    bool ok;
+    GzipStream outer;
+    if (hasGzipMagic(data)) {
+        ok = outer.feed(data.data(), size_t(data.size()), payloadSink);
+        if (ok && !outer.isFinished()) {
+            ok = false;
+            error = "Truncated .seb file";
+        }
+        if (ok && payload == Payload::Unknown) {
+            ok = decide();
+        }
+    } else {
+        // Uncompressed file: hand the mapped data on without copying it
+        const int consumed = classify(data.first(qMin<qsizetype>(data.size(), 4)));
+        ok = consumed >= 0;
+        if (ok && payload == Payload::Plain) {
+            ok = plist.parse(data);
+        } else if (ok) {
+            const QByteArrayView rest = data.sliced(consumed);
+            ok = inner.feed(rest.data(), size_t(rest.size()), xmlSink);
+        }
+    }
+    if (ok && payload == Payload::Compressed && !inner.isFinished()) {
+        ok = false;
+        error = "Truncated compressed plist payload";
+    }
+    if (ok) {
+        ok = plist.finish();
+    }
+
+    if (!ok) {
+        if (error.isEmpty()) {
+            error = !plist.errorString().isEmpty() ? plist.errorString()
+                  : !inner.errorString().isEmpty() ? inner.errorString()
+                  : outer.errorString();
+        }
+        return SebFileResult(error.isEmpty() ? QString("Invalid .seb file") : error);
+    }
+
+    if (!plist.root().isObject()) {
+        return SebFileResult("Root plist element is not a dictionary");
+    }
+    return SebFileResult(plist.root().toObject());
+}
+
+} // namespace core
+} // namespace seb
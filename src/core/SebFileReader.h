@@ -0,0 +1,41 @@
+#ifndef SEB_CORE_SEB_FILE_READER_H
+#define SEB_CORE_SEB_FILE_READER_H
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+namespace seb {
+namespace core {
+
+struct SebFileResult {
+    QJsonObject settings;
+    bool success;
+    QString errorMessage;
+
+    SebFileResult() : success(false) {}
+    SebFileResult(const QJsonObject& s) : settings(s), success(true) {}
+    SebFileResult(const QString& error) : success(false), errorMessage(error) {}
+};
+
+// Reader for native SEB configuration files.
+//
+// A .seb file is gzip(prefix + payload) where the 4-byte prefix "plnd"
+// marks an unencrypted payload that is itself gzip-compressed XML plist.
+// Plain and gzip-compressed XML plists are accepted as well. The data is
+// inflated and parsed in a single streaming pass; plist values map to JSON
+// as dict -> object, array -> array, <data> -> base64 string,
+// <date> -> string.
+class SebFileReader {
+public:
+    // Parse the (usually memory-mapped) file contents
+    static SebFileResult read(QByteArrayView data);
+
+    // True if the data looks like a .seb file or an XML plist
+    static bool isSebData(QByteArrayView data);
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_SEB_FILE_READER_H
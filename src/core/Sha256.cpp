@@ -0,0 +1,247 @@
+#include "Sha256.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SEB_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace seb {
+namespace core {
+
+namespace {
+
+using CompressFunction = void (*)(quint32* state, const quint8* blocks, size_t blockCount);
+
+alignas(16) const quint32 RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline quint32 rotr(quint32 x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+void compressPortable(quint32* state, const quint8* blocks, size_t blockCount) {
+    quint32 w[64];
+
+    for (size_t block = 0; block < blockCount; ++block, blocks += 64) {
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (quint32(blocks[i * 4]) << 24) | (quint32(blocks[i * 4 + 1]) << 16)
+                 | (quint32(blocks[i * 4 + 2]) << 8) | quint32(blocks[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            quint32 s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            quint32 s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        quint32 a = state[0], b = state[1], c = state[2], d = state[3];
+        quint32 e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i) {
+            quint32 s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            quint32 ch = (e & f) ^ (~e & g);
+            quint32 t1 = h + s1 + ch + RoundConstants[i] + w[i];
+            quint32 s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            quint32 maj = (a & b) ^ (a & c) ^ (b & c);
+            quint32 t2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef SEB_SHA256_X86
+__attribute__((target("sha,sse4.1,ssse3")))
+void compressShaNi(quint32* state, const quint8* blocks, size_t blockCount) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions operate on the state as ABEF / CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (size_t block = 0; block < blockCount; ++block, blocks += 64) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+
+        for (int i = 0; i < 16; ++i) {
+            if (i < 4) {
+                msg[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), byteSwap);
+            } else {
+                // W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16], four words at a time
+                __m128i w = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(w, msg[(i + 3) & 3]);
+            }
+
+            __m128i k = _mm_add_epi32(msg[i & 3],
+                _mm_load_si128(reinterpret_cast<const __m128i*>(&RoundConstants[i * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(k, 0x0E));
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    // Back to ABCD / EFGH
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+bool cpuHasShaNi() {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool hasSse41 = ecx & bit_SSE4_1;
+    const bool hasSsse3 = ecx & bit_SSSE3;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool hasSha = ebx & (1u << 29);
+    return hasSse41 && hasSsse3 && hasSha;
+}
+#endif
+
+CompressFunction selectCompressFunction() {
+#ifdef SEB_SHA256_X86
+    if (cpuHasShaNi()) {
+        return compressShaNi;
+    }
+#endif
+    return compressPortable;
+}
+
+const CompressFunction compress = selectCompressFunction();
+
+} // namespace
+
+Sha256::Sha256(Implementation implementation)
+    : m_compress(implementation == Implementation::Portable ? compressPortable : compress)
+{
+    reset();
+}
+
+void Sha256::reset() {
+    static const quint32 initialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    std::memcpy(m_state, initialState, sizeof(m_state));
+    m_length = 0;
+    m_bufferSize = 0;
+}
+
+void Sha256::addData(const char* data, qsizetype length) {
+    if (length <= 0) {
+        return;
+    }
+
+    const quint8* bytes = reinterpret_cast<const quint8*>(data);
+    size_t remaining = size_t(length);
+    m_length += remaining;
+
+    // Complete a partially filled block first
+    if (m_bufferSize > 0) {
+        size_t take = qMin(remaining, size_t(64 - m_bufferSize));
+        std::memcpy(m_buffer + m_bufferSize, bytes, take);
+        m_bufferSize += int(take);
+        bytes += take;
+        remaining -= take;
+        if (m_bufferSize < 64) {
+            return;
+        }
+        m_compress(m_state, m_buffer, 1);
+        m_bufferSize = 0;
+    }
+
+    // Hash whole blocks straight from the input
+    if (remaining >= 64) {
+        size_t blockCount = remaining / 64;
+        m_compress(m_state, bytes, blockCount);
+        bytes += blockCount * 64;
+        remaining -= blockCount * 64;
+    }
+
+    if (remaining > 0) {
+        std::memcpy(m_buffer, bytes, remaining);
+        m_bufferSize = int(remaining);
+    }
+}
+
+QByteArray Sha256::result() {
+    const quint64 bitLength = m_length * 8;
+
+    // Padding: 0x80, zeros, then the 64-bit big-endian message length
+    m_buffer[m_bufferSize++] = 0x80;
+    if (m_bufferSize > 56) {
+        std::memset(m_buffer + m_bufferSize, 0, size_t(64 - m_bufferSize));
+        m_compress(m_state, m_buffer, 1);
+        m_bufferSize = 0;
+    }
+    std::memset(m_buffer + m_bufferSize, 0, size_t(56 - m_bufferSize));
+    for (int i = 0; i < 8; ++i) {
+        m_buffer[56 + i] = quint8(bitLength >> (56 - i * 8));
+    }
+    m_compress(m_state, m_buffer, 1);
+    m_bufferSize = 0;
+
+    QByteArray digest(DigestSize, Qt::Uninitialized);
+    for (int i = 0; i < 8; ++i) {
+        digest[i * 4] = char(m_state[i] >> 24);
+        digest[i * 4 + 1] = char(m_state[i] >> 16);
+        digest[i * 4 + 2] = char(m_state[i] >> 8);
+        digest[i * 4 + 3] = char(m_state[i]);
+    }
+    return digest;
+}
+
+QByteArray Sha256::hash(QByteArrayView data) {
+    Sha256 sha;
+    sha.addData(data);
+    return sha.result();
+}
+
+bool Sha256::isHardwareAccelerated() {
+#ifdef SEB_SHA256_X86
+    return compress == compressShaNi;
+#else
+    return false;
+#endif
+}
+
+} // namespace core
+} // namespace seb
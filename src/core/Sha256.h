@@ -0,0 +1,45 @@
+#ifndef SEB_CORE_SHA256_H
+#define SEB_CORE_SHA256_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QtGlobal>
+
+namespace seb {
+namespace core {
+
+// Incremental SHA-256.
+//
+// Uses the x86 SHA extensions (SHA-NI) when the CPU supports them and a
+// portable implementation otherwise; the choice is made once per process.
+// Implementation::Portable forces the portable path, e.g. to cross-check SHA-NI.
+class Sha256 {
+public:
+    static constexpr int DigestSize = 32;
+
+    enum class Implementation { Auto, Portable };
+
+    explicit Sha256(Implementation implementation = Implementation::Auto);
+
+    void reset();
+    void addData(const char* data, qsizetype length);
+    void addData(QByteArrayView data) { addData(data.data(), data.size()); }
+
+    // Finalize and return the raw 32-byte digest; call reset() to reuse
+    QByteArray result();
+
+    static QByteArray hash(QByteArrayView data);
+    static bool isHardwareAccelerated();
+
+private:
+    void (*m_compress)(quint32* state, const quint8* blocks, size_t blockCount);
+    quint32 m_state[8];
+    quint8 m_buffer[64];
+    quint64 m_length;
+    int m_bufferSize;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_SHA256_H
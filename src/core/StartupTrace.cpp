@@ -0,0 +1,104 @@
+#include "StartupTrace.h"
+#include "Logging.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QDebug>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace seb {
+namespace core {
+
+StartupTrace& StartupTrace::instance() {
+    static StartupTrace trace;
+    return trace;
+}
+
+StartupTrace::StartupTrace()
+    : m_startEpochMs(QDateTime::currentMSecsSinceEpoch())
+    , m_enabled(false)
+{
+    m_clock.start();
+}
+
+void StartupTrace::enable(const QString& outputPath) {
+    QMutexLocker locker(&m_mutex);
+    m_outputPath = outputPath;
+    m_enabled = !outputPath.isEmpty();
+}
+
+qint64 StartupTrace::now() const {
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+void StartupTrace::addSpan(const QString& name, qint64 startUs, qint64 endUs) {
+    if (!m_enabled) {
+        return;
+    }
+    record(Event{name, 'X', startUs, qMax<qint64>(endUs - startUs, 0), 0});
+}
+
+void StartupTrace::addInstant(const QString& name, qint64 timestampUs) {
+    if (!m_enabled) {
+        return;
+    }
+    record(Event{name, 'i', timestampUs, 0, 0});
+}
+
+qint64 StartupTrace::fromEpochMs(double epochMs) const {
+    return qint64((epochMs - double(m_startEpochMs)) * 1000.0);
+}
+
+void StartupTrace::record(const Event& event) {
+    Event withThread = event;
+    withThread.threadId = qint64(::syscall(SYS_gettid));
+
+    QMutexLocker locker(&m_mutex);
+    m_events.append(withThread);
+}
+
+bool StartupTrace::finish() {
+    if (!m_enabled) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+    for (const Event& event : std::as_const(m_events)) {
+        QJsonObject entry;
+        entry["name"] = event.name;
+        entry["cat"] = "startup";
+        entry["ph"] = QString(QLatin1Char(event.phase));
+        entry["ts"] = event.timestampUs;
+        entry["pid"] = pid;
+        entry["tid"] = event.threadId;
+        if (event.phase == 'X') {
+            entry["dur"] = event.durationUs;
+        } else {
+            entry["s"] = "g";
+        }
+        traceEvents.append(entry);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(m_outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcTrace) << "Failed to write startup trace:" << m_outputPath;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qCDebug(lcTrace) << "Startup trace written to" << m_outputPath << "with" << m_events.size() << "events";
+    return true;
+}
+
+} // namespace core
+} // namespace seb
@@ -0,0 +1,74 @@
+#ifndef SEB_CORE_STARTUP_TRACE_H
+#define SEB_CORE_STARTUP_TRACE_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+namespace seb {
+namespace core {
+
+// Records named startup spans with monotonic timestamps and writes them as
+// Chrome trace-event JSON (viewable in Perfetto / chrome://tracing).
+// Recording is a no-op unless enabled with an output file.
+class StartupTrace {
+public:
+    static StartupTrace& instance();
+
+    void enable(const QString& outputPath);
+    bool isEnabled() const { return m_enabled; }
+
+    // Microseconds since the trace clock started
+    qint64 now() const;
+
+    void addSpan(const QString& name, qint64 startUs, qint64 endUs);
+    void addInstant(const QString& name, qint64 timestampUs);
+
+    // Map a wall-clock time (ms since epoch, e.g. from JavaScript) to the
+    // trace clock
+    qint64 fromEpochMs(double epochMs) const;
+
+    // Write the trace file; later calls rewrite it with any new events
+    bool finish();
+
+    // Records the lifetime of a scope as a span
+    class Span {
+    public:
+        explicit Span(const QString& name)
+            : m_name(name), m_start(StartupTrace::instance().now()) {}
+        ~Span() { StartupTrace::instance().addSpan(m_name, m_start, StartupTrace::instance().now()); }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        QString m_name;
+        qint64 m_start;
+    };
+
+private:
+    StartupTrace();
+
+    struct Event {
+        QString name;
+        char phase;
+        qint64 timestampUs;
+        qint64 durationUs;
+        qint64 threadId;
+    };
+
+    void record(const Event& event);
+
+    QElapsedTimer m_clock;
+    qint64 m_startEpochMs;
+    bool m_enabled;
+    QString m_outputPath;
+    QMutex m_mutex;
+    QList<Event> m_events;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_STARTUP_TRACE_H
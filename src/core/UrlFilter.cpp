@@ -0,0 +1,243 @@
+#include "UrlFilter.h"
+
+namespace seb {
+namespace core {
+
+namespace {
+
+// Escape a wildcard expression part, turning "*" into the given pattern
+QString escapeWildcard(QStringView part, const QString& wildcard) {
+    QString pattern;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= part.size(); ++i) {
+        if (i == part.size() || part[i] == u'*') {
+            pattern += QRegularExpression::escape(part.mid(start, i - start).toString());
+            if (i < part.size()) {
+                pattern += wildcard;
+            }
+            start = i + 1;
+        }
+    }
+    return pattern;
+}
+
+// Hosts are matched in ACE form; wildcard hosts that IDNA rejects stay as written
+QString aceHost(QStringView host) {
+    const QString lower = host.toString().toLower();
+    const QByteArray ace = QUrl::toAce(lower);
+    return ace.isEmpty() ? lower : QString::fromLatin1(ace);
+}
+
+// URL in the canonical form the rules are matched against
+QString matchString(const QUrl& url) {
+    const QString scheme = url.scheme().toLower();
+    const int defaultPort = scheme == QLatin1String("https") || scheme == QLatin1String("wss") ? 443
+                          : scheme == QLatin1String("http") || scheme == QLatin1String("ws") ? 80
+                          : -1;
+
+    QString result = scheme + QLatin1String("://") + url.host(QUrl::FullyEncoded);
+    const int port = url.port();
+    if (port >= 0 && port != defaultPort) {
+        result += QLatin1Char(':') + QString::number(port);
+    }
+
+    const QString path = url.path(QUrl::FullyEncoded);
+    result += path.isEmpty() ? QStringLiteral("/") : path;
+    if (url.hasQuery()) {
+        result += QLatin1Char('?') + url.query(QUrl::FullyEncoded);
+    }
+    return result;
+}
+
+} // namespace
+
+UrlFilter::UrlFilter(const QList<UrlFilterRule>& rules) {
+    QString combined = QStringLiteral("^(?:");
+    int groupCount = 0;
+
+    for (const UrlFilterRule& rule : rules) {
+        if (!rule.active) {
+            continue;
+        }
+
+        QString error;
+        const QString pattern = ruleToPattern(rule, &error);
+        if (pattern.isEmpty()) {
+            m_errorString = error;
+            m_groupActions.clear();
+            return;
+        }
+
+        if (!m_groupActions.isEmpty()) {
+            combined += QLatin1Char('|');
+        }
+        combined += pattern + QLatin1String("()");
+
+        // Groups inside the rule come first, the empty marker group last
+        groupCount += QRegularExpression(pattern).captureCount() + 1;
+        m_groupActions.resize(groupCount + 1, -1);
+        m_groupActions[groupCount] = int(rule.action);
+    }
+
+    if (m_groupActions.isEmpty()) {
+        return;
+    }
+
+    combined += QLatin1Char(')');
+    m_combined.setPattern(combined);
+    m_combined.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    if (!m_combined.isValid()) {
+        m_errorString = QString("Invalid URL filter: %1").arg(m_combined.errorString());
+        m_groupActions.clear();
+        return;
+    }
+    m_combined.optimize();
+}
+
+UrlFilter::UrlFilter(const QString& pattern, const QList<int>& groupActions)
+    : m_groupActions(groupActions)
+{
+    if (m_groupActions.isEmpty()) {
+        return;
+    }
+
+    m_combined.setPattern(pattern);
+    m_combined.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    if (!m_combined.isValid() || m_combined.captureCount() + 1 != int(m_groupActions.size())) {
+        m_errorString = QString("Invalid precompiled URL filter: %1").arg(m_combined.errorString());
+        m_groupActions.clear();
+        return;
+    }
+    m_combined.optimize();
+}
+
+UrlFilter::Verdict UrlFilter::evaluate(const QUrl& url) const {
+    if (m_groupActions.isEmpty()) {
+        return Verdict::NoMatch;
+    }
+
+    const QRegularExpressionMatch match = m_combined.match(matchString(url));
+    if (!match.hasMatch()) {
+        return Verdict::NoMatch;
+    }
+
+    const int group = match.lastCapturedIndex();
+    if (group < 0 || group >= int(m_groupActions.size()) || m_groupActions[group] < 0) {
+        return Verdict::NoMatch;
+    }
+    return m_groupActions[group] == int(UrlFilterRule::Action::Allow) ? Verdict::Allow : Verdict::Block;
+}
+
+QString UrlFilter::ruleToPattern(const UrlFilterRule& rule, QString* errorString) {
+    const QString expression = rule.expression.trimmed();
+    if (expression.isEmpty()) {
+        if (errorString) {
+            *errorString = "URL filter rule has an empty expression";
+        }
+        return QString();
+    }
+
+    if (!rule.regex) {
+        return QLatin1String("(?:") + wildcardToPattern(expression) + QLatin1String(")$");
+    }
+
+    QRegularExpression regex(expression);
+    if (!regex.isValid()) {
+        if (errorString) {
+            *errorString = QString("Invalid URL filter regex '%1': %2").arg(expression, regex.errorString());
+        }
+        return QString();
+    }
+    // Numbered back references would point at other rules' groups once combined
+    static const QRegularExpression backReference(QStringLiteral(R"((?<!\\)(?:\\\\)*\\(?:[1-9]|g\{?-?[0-9]))"));
+    if (backReference.match(expression).hasMatch()) {
+        if (errorString) {
+            *errorString = QString("URL filter regex '%1' uses numbered back references").arg(expression);
+        }
+        return QString();
+    }
+    // Unanchored: the regex may match anywhere in the URL
+    return QLatin1String(".*?(?:") + expression + QLatin1Char(')');
+}
+
+QString UrlFilter::wildcardToPattern(const QString& expression) {
+    QStringView rest(expression);
+    QString pattern;
+
+    // Scheme
+    const qsizetype schemeEnd = rest.indexOf(u"://");
+    if (schemeEnd >= 0) {
+        pattern += escapeWildcard(rest.left(schemeEnd), QStringLiteral("[a-z0-9+.-]*"));
+        rest = rest.mid(schemeEnd + 3);
+    } else {
+        pattern += QLatin1String("[a-z0-9+.-]+");
+    }
+    pattern += QLatin1String("://");
+
+    // Authority, dropping any user:password@
+    qsizetype authorityEnd = 0;
+    while (authorityEnd < rest.size() && rest[authorityEnd] != u'/' && rest[authorityEnd] != u'?') {
+        ++authorityEnd;
+    }
+    QStringView authority = rest.left(authorityEnd);
+    rest = rest.mid(authorityEnd);
+    const qsizetype at = authority.lastIndexOf(u'@');
+    if (at >= 0) {
+        authority = authority.mid(at + 1);
+    }
+
+    QStringView host = authority;
+    QStringView port;
+    const qsizetype colon = authority.lastIndexOf(u':');
+    if (colon >= 0 && authority.indexOf(u']') < colon) {
+        host = authority.left(colon);
+        port = authority.mid(colon + 1);
+    }
+
+    const QString hostWildcard = QStringLiteral("[^/:?]*");
+    if (host.startsWith(u'.')) {
+        // Leading dot: exactly this host
+        pattern += escapeWildcard(aceHost(host.mid(1)), hostWildcard);
+    } else {
+        pattern += QLatin1String("(?:[^/:?]*\\.)?") + escapeWildcard(aceHost(host), hostWildcard);
+    }
+
+    // Default ports are not part of the matched URL
+    if (port.isEmpty()) {
+        pattern += QLatin1String("(?::[0-9]+)?");
+    } else {
+        pattern += QLatin1String("(?::") + escapeWildcard(port, QStringLiteral("[0-9]*")) + QLatin1Char(')');
+        if (port == u"80" || port == u"443") {
+            pattern += QLatin1Char('?');
+        }
+    }
+
+    // Path
+    QStringView path = rest;
+    QStringView query;
+    const qsizetype questionMark = rest.indexOf(u'?');
+    if (questionMark >= 0) {
+        path = rest.left(questionMark);
+        query = rest.mid(questionMark + 1);
+    }
+
+    const QString pathWildcard = QStringLiteral("[^?]*");
+    if (path.isEmpty() || path == u"/") {
+        pattern += QLatin1String("/[^?]*");
+    } else if (path.endsWith(u'/')) {
+        pattern += escapeWildcard(path, pathWildcard) + pathWildcard;
+    } else {
+        pattern += escapeWildcard(path, pathWildcard) + QLatin1String("(?:/[^?]*)?");
+    }
+
+    // Query
+    if (questionMark >= 0) {
+        pattern += QLatin1String("\\?") + escapeWildcard(query, QStringLiteral(".*"));
+    } else {
+        pattern += QLatin1String("(?:\\?.*)?");
+    }
+    return pattern;
+}
+
+} // namespace core
+} // namespace seb
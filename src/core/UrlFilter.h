@@ -0,0 +1,66 @@
+#ifndef SEB_CORE_URL_FILTER_H
+#define SEB_CORE_URL_FILTER_H
+
+#include "Config.h"
+#include <QtCore/QList>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+namespace seb {
+namespace core {
+
+// Ordered URL filter compiled into a single matcher.
+//
+// All active rules are combined into one anchored alternation, JIT-compiled
+// once, with an empty marker group closing each alternative. The regex
+// engine tries alternatives in rule order, so the marker that captured
+// identifies the first matching rule, found in one pass over the URL.
+//
+// Wildcard expressions follow SEB syntax: [scheme://]host[:port][/path][?query]
+// with "*" wildcards. A host matches itself and its subdomains unless it is
+// written with a leading "." (exact host). A path matches itself and
+// everything below it. Omitted parts match anything. Regular expressions are
+// matched anywhere in the URL. URLs are matched as
+// scheme://host[:port]/path[?query], without user info, fragment or default
+// port.
+class UrlFilter {
+public:
+    enum class Verdict {
+        NoMatch,
+        Allow,
+        Block
+    };
+
+    UrlFilter() = default;
+    explicit UrlFilter(const QList<UrlFilterRule>& rules);
+
+    // Restore a filter from pattern() and groupActions() of a compiled one;
+    // skips translating the rules, the regex itself is compiled again
+    UrlFilter(const QString& pattern, const QList<int>& groupActions);
+
+    QString pattern() const { return m_combined.pattern(); }
+    const QList<int>& groupActions() const { return m_groupActions; }
+
+    bool isEmpty() const { return m_groupActions.isEmpty(); }
+    bool isValid() const { return m_errorString.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+    Verdict evaluate(const QUrl& url) const;
+
+    // Regex source for a single rule; empty with an error message on failure
+    static QString ruleToPattern(const UrlFilterRule& rule, QString* errorString = nullptr);
+
+private:
+    static QString wildcardToPattern(const QString& expression);
+
+    QRegularExpression m_combined;
+    // Capture group index -> action of the rule whose marker it is (-1: none)
+    QList<int> m_groupActions;
+    QString m_errorString;
+};
+
+} // namespace core
+} // namespace seb
+
+#endif // SEB_CORE_URL_FILTER_H
@@ -0,0 +1,50 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCommandLineOption>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonDocument>
+#include <cstdio>
+#include "../core/AuditLog.h"
+
+// Dumps a seb-linux binary audit log as JSON to stdout
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("seb-audit-dump");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Dump a seb-linux audit log as JSON");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("audit-log", "Audit log file written by seb-linux");
+
+    QCommandLineOption compactOption("compact", "Write compact JSON on a single line");
+    parser.addOption(compactOption);
+
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1) {
+        qCritical() << "Error: expected exactly one audit log file";
+        qCritical() << parser.helpText();
+        return 1;
+    }
+
+    QString error;
+    QJsonObject root = seb::core::AuditLogReader::toJson(arguments.first(), &error);
+    if (!error.isEmpty()) {
+        qCritical() << "Error: Failed to read audit log" << arguments.first() << ":" << error;
+        return 1;
+    }
+
+    const QByteArray json = QJsonDocument(root).toJson(parser.isSet(compactOption)
+                                                           ? QJsonDocument::Compact
+                                                           : QJsonDocument::Indented);
+    std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    if (root["corruptBlocks"].toInt() > 0) {
+        qWarning() << "Warning:" << root["corruptBlocks"].toInt() << "blocks failed the CRC check";
+        return 2;
+    }
+    return 0;
+}
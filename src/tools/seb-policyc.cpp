@@ -0,0 +1,82 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCommandLineOption>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include "../core/ConfigLoader.h"
+#include "../core/PolicyBlob.h"
+
+// Compiles a seb-linux policy (JSON or .seb) into a binary policy blob
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("seb-policyc");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compile a seb-linux policy into a binary policy file");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("config-file", "JSON or .seb configuration file");
+
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+                                    "Write the compiled policy to <file> (default: <config-file>.sebp)",
+                                    "file");
+    parser.addOption(outputOption);
+
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1) {
+        qCritical() << "Error: expected exactly one configuration file";
+        qCritical() << parser.helpText();
+        return 1;
+    }
+    const QString inputPath = arguments.first();
+
+    seb::core::ConfigLoadResult result = seb::core::ConfigLoader::loadFromFile(inputPath);
+    if (!result.success) {
+        qCritical() << "Error: Failed to load configuration from:" << inputPath;
+        qCritical() << "Error details:" << result.errorMessage;
+        return 1;
+    }
+    if (!result.policy.isValid()) {
+        qCritical() << "Error: Configuration validation failed";
+        qCritical() << "The startUrl field is invalid or missing";
+        return 1;
+    }
+
+    QString error;
+    const QByteArray blob = seb::core::PolicyBlob::compile(result.policy, &error);
+    if (blob.isEmpty()) {
+        qCritical() << "Error: Failed to compile policy:" << error;
+        return 1;
+    }
+
+    QString outputPath = parser.value(outputOption);
+    if (outputPath.isEmpty()) {
+        const QFileInfo input(inputPath);
+        outputPath = input.path() + "/" + input.completeBaseName() + ".sebp";
+    }
+
+    // Renamed over the old file, so running kiosks keep their mapping intact
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(blob) != blob.size() || !file.commit()) {
+        qCritical() << "Error: Failed to write" << outputPath << ":" << file.errorString();
+        return 1;
+    }
+
+    // Check that the result loads
+    if (!seb::core::PolicyBlob::open(outputPath, &error)) {
+        qCritical() << "Error:" << error;
+        return 1;
+    }
+
+    qInfo().noquote() << QString("%1: %2 allowed domains, %3 URL filter rules, %4 bytes")
+                             .arg(outputPath)
+                             .arg(result.policy.allowedDomains.size())
+                             .arg(result.policy.urlFilterRules.size())
+                             .arg(blob.size());
+    return 0;
+}
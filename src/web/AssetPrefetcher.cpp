@@ -0,0 +1,173 @@
+#include "AssetPrefetcher.h"
+#include "../core/Logging.h"
+#include <QtWebEngineCore/QWebEnginePage>
+#include <QtWebEngineCore/QWebEngineProfile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTimer>
+#include <QtCore/QUrl>
+#include <QtCore/QDebug>
+#include <functional>
+
+namespace seb {
+namespace web {
+
+namespace {
+
+const QString ConsolePrefix = QStringLiteral("seb-prefetch:");
+
+// Hidden page reporting prefetch progress through console messages
+class PrefetchPage : public QWebEnginePage {
+public:
+    PrefetchPage(QWebEngineProfile* profile, std::function<void(const QString&)> onMessage, QObject* parent)
+        : QWebEnginePage(profile, parent)
+        , m_onMessage(std::move(onMessage))
+    {
+    }
+
+protected:
+    void javaScriptConsoleMessage(JavaScriptConsoleMessageLevel level, const QString& message,
+                                  int lineNumber, const QString& sourceID) override {
+        Q_UNUSED(level);
+        Q_UNUSED(lineNumber);
+        Q_UNUSED(sourceID);
+        if (message.startsWith(ConsolePrefix)) {
+            m_onMessage(message.mid(ConsolePrefix.size()));
+        }
+    }
+
+private:
+    std::function<void(const QString&)> m_onMessage;
+};
+
+} // namespace
+
+AssetPrefetcher::AssetPrefetcher(QWebEngineProfile* profile,
+                                 const core::PrefetchSettings& settings,
+                                 const QString& startUrl,
+                                 QObject* parent)
+    : QObject(parent)
+    , m_profile(profile)
+    , m_settings(settings)
+    , m_startUrl(startUrl)
+    , m_page(nullptr)
+{
+}
+
+void AssetPrefetcher::start() {
+    if (!m_settings.isEnabled() || m_page) {
+        return;
+    }
+
+    // Spread the load of a whole exam room over the jitter window
+    // (jitterMs is range checked by the config loader, so +1 cannot overflow)
+    int delayMs = m_settings.jitterMs > 0 ? QRandomGenerator::global()->bounded(m_settings.jitterMs + 1) : 0;
+    qCDebug(core::lcPrefetch) << "Prefetching" << m_settings.urls.size() << "assets in" << delayMs << "ms"
+             << (m_settings.manifestUrl.isEmpty() ? QString() : "plus manifest " + m_settings.manifestUrl);
+    QTimer::singleShot(delayMs, this, &AssetPrefetcher::runPrefetch);
+}
+
+void AssetPrefetcher::runPrefetch() {
+    m_page = new PrefetchPage(m_profile, [this](const QString& message) {
+        handleConsoleMessage(message);
+    }, this);
+
+    connect(m_page, &QWebEnginePage::loadFinished, this, [this](bool ok) {
+        if (!m_page) {
+            return;
+        }
+        if (!ok) {
+            qCWarning(core::lcPrefetch) << "Prefetch page failed to load";
+            releasePage();
+            return;
+        }
+        m_page->runJavaScript(buildScript());
+    });
+
+    // Empty document on the exam origin: fetches share its cache partition
+    QUrl origin = QUrl(m_startUrl).adjusted(QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment);
+    m_page->setHtml("<!DOCTYPE html><html><head><title>prefetch</title></head><body></body></html>", origin);
+}
+
+void AssetPrefetcher::handleConsoleMessage(const QString& message) {
+    // Late messages may still arrive before the released page is deleted
+    if (!m_page) {
+        return;
+    }
+
+    if (message.startsWith("done:")) {
+        const QStringList counts = message.mid(5).split(':');
+        qCDebug(core::lcPrefetch) << "Prefetch finished:" << counts.value(0) << "fetched," << counts.value(1) << "failed";
+    } else {
+        qCWarning(core::lcPrefetch) << "Prefetch error:" << message;
+    }
+
+    releasePage();
+}
+
+void AssetPrefetcher::releasePage() {
+    // Release the hidden page and its renderer
+    m_page->deleteLater();
+    m_page = nullptr;
+}
+
+QString AssetPrefetcher::buildScript() const {
+    const QString urls = QString::fromUtf8(
+        QJsonDocument(QJsonArray::fromStringList(m_settings.urls)).toJson(QJsonDocument::Compact));
+    const QString manifestUrl = QString::fromUtf8(
+        QJsonDocument(QJsonArray{m_settings.manifestUrl}).toJson(QJsonDocument::Compact));
+
+    // Manifest: JSON array, {"urls": [...]} or one URL per line; relative
+    // URLs resolve against the manifest. no-cors responses are opaque but
+    // still stored in the HTTP cache.
+    return QString(R"(
+(function(urls, manifestUrl, concurrency) {
+    function fetchOne(url) {
+        return fetch(url, { mode: 'no-cors', credentials: 'include' })
+            .then(function(response) { return response.blob(); })
+            .then(function() { return true; }, function() { return false; });
+    }
+    function parseManifest(text) {
+        var list;
+        try {
+            var json = JSON.parse(text);
+            list = Array.isArray(json) ? json : (json.urls || []);
+        } catch (e) {
+            list = text.split(/\r?\n/);
+        }
+        return list.map(function(u) { return String(u).trim(); })
+                   .filter(function(u) { return u.length > 0; })
+                   .map(function(u) { return new URL(u, manifestUrl).href; });
+    }
+    var manifest = manifestUrl
+        ? fetch(manifestUrl, { credentials: 'include' }).then(function(r) { return r.text(); }).then(parseManifest)
+        : Promise.resolve([]);
+    manifest.then(function(extra) {
+        var list = urls.concat(extra);
+        var index = 0, fetched = 0, failed = 0;
+        function next() {
+            if (index >= list.length) {
+                return Promise.resolve();
+            }
+            return fetchOne(list[index++]).then(function(ok) {
+                ok ? fetched++ : failed++;
+                return next();
+            });
+        }
+        var workers = [];
+        for (var i = 0; i < Math.min(concurrency, list.length); i++) {
+            workers.push(next());
+        }
+        return Promise.all(workers).then(function() {
+            console.info('seb-prefetch:done:' + fetched + ':' + failed);
+        });
+    }).catch(function(e) {
+        console.info('seb-prefetch:error:' + e);
+    });
+})(%1, %2[0], %3);
+)").arg(urls, manifestUrl, QString::number(m_settings.concurrency));
+}
+
+} // namespace web
+} // namespace seb
@@ -0,0 +1,49 @@
+#ifndef SEB_WEB_ASSET_PREFETCHER_H
+#define SEB_WEB_ASSET_PREFETCHER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include "../core/Config.h"
+
+class QWebEngineProfile;
+class QWebEnginePage;
+
+namespace seb {
+namespace web {
+
+// Warms the profile's HTTP cache with exam assets before the exam starts.
+//
+// Started once the start page has loaded, so the fetches fill the pre-exam
+// window instead of competing with the start page load. After a random
+// delay within the policy's jitter window, a hidden page on
+// the start URL's origin (so the partitioned HTTP cache entries are the ones
+// the exam page will use) fetches the configured URLs and the manifest's
+// URLs with a bounded number of parallel requests. Requests go through the
+// profile's interceptor, so blocked hosts stay blocked.
+class AssetPrefetcher : public QObject {
+    Q_OBJECT
+
+public:
+    AssetPrefetcher(QWebEngineProfile* profile,
+                    const core::PrefetchSettings& settings,
+                    const QString& startUrl,
+                    QObject* parent = nullptr);
+
+    void start();
+
+private:
+    void runPrefetch();
+    void handleConsoleMessage(const QString& message);
+    void releasePage();
+    QString buildScript() const;
+
+    QWebEngineProfile* m_profile;
+    core::PrefetchSettings m_settings;
+    QString m_startUrl;
+    QWebEnginePage* m_page;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_ASSET_PREFETCHER_H
@@ -0,0 +1,245 @@
+#include "KeyboardLockdown.h"
+#include "../core/Logging.h"
+#include <QtGui/QGuiApplication>
+#include <QtGui/QKeyEvent>
+#include <QtWidgets/QApplication>
+#include <QtCore/QDebug>
+
+#ifdef SEB_HAVE_X11
+#include <QtGui/qguiapplication_platform.h>
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+#include <xcb/xcb.h>
+// Xlib macros that collide with Qt names
+#undef None
+#undef KeyPress
+#undef KeyRelease
+#undef Bool
+#undef Status
+#endif
+
+namespace seb {
+namespace web {
+
+namespace {
+
+#ifdef SEB_HAVE_X11
+bool grabFailed = false;
+
+// XGrabKey reports BadAccess when another client holds the grab; the
+// default Xlib handler would exit the process
+int recordGrabError(Display*, XErrorEvent*) {
+    grabFailed = true;
+    return 0;
+}
+
+KeySym keysymFor(int key) {
+    if (key >= Qt::Key_A && key <= Qt::Key_Z) {
+        return XK_a + (key - Qt::Key_A);
+    }
+    if (key >= Qt::Key_0 && key <= Qt::Key_9) {
+        return XK_0 + (key - Qt::Key_0);
+    }
+    if (key >= Qt::Key_F1 && key <= Qt::Key_F35) {
+        return XK_F1 + (key - Qt::Key_F1);
+    }
+    switch (key) {
+    case Qt::Key_Escape: return XK_Escape;
+    case Qt::Key_Tab: return XK_Tab;
+    case Qt::Key_Backspace: return XK_BackSpace;
+    case Qt::Key_Return: return XK_Return;
+    case Qt::Key_Delete: return XK_Delete;
+    case Qt::Key_Space: return XK_space;
+    case Qt::Key_Print: return XK_Print;
+    default: return NoSymbol;
+    }
+}
+
+unsigned int x11Modifiers(Qt::KeyboardModifiers modifiers) {
+    unsigned int mask = 0;
+    if (modifiers & Qt::ShiftModifier) {
+        mask |= ShiftMask;
+    }
+    if (modifiers & Qt::ControlModifier) {
+        mask |= ControlMask;
+    }
+    if (modifiers & Qt::AltModifier) {
+        mask |= Mod1Mask;
+    }
+    if (modifiers & Qt::MetaModifier) {
+        mask |= Mod4Mask;
+    }
+    return mask;
+}
+#endif
+
+} // namespace
+
+KeyboardLockdown::KeyboardLockdown(const ShortcutTable& table, QObject* parent)
+    : QObject(parent)
+    , m_table(table)
+    , m_installed(false)
+    , m_rootWindow(0)
+{
+}
+
+KeyboardLockdown::~KeyboardLockdown() {
+    if (m_installed) {
+        qApp->removeEventFilter(this);
+        qApp->removeNativeEventFilter(this);
+        ungrabX11Keys();
+    }
+}
+
+void KeyboardLockdown::install() {
+    if (m_installed) {
+        return;
+    }
+    m_installed = true;
+
+    qApp->installEventFilter(this);
+    if (QGuiApplication::platformName() == QLatin1String("xcb")) {
+        qApp->installNativeEventFilter(this);
+        grabX11Keys();
+    }
+    qCDebug(core::lcWindow) << "Shortcut table active with" << m_table.entries().size() << "rules";
+}
+
+bool KeyboardLockdown::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() != QEvent::KeyPress) {
+        return QObject::eventFilter(watched, event);
+    }
+
+    QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+    switch (m_table.lookup(keyEvent->key(), keyEvent->modifiers())) {
+    case ShortcutTable::Action::None:
+        break;
+    case ShortcutTable::Action::Block:
+        if (!keyEvent->isAutoRepeat()) {
+            qCWarning(core::lcWindow).noquote() << "Shortcut blocked ("
+                << ShortcutTable::toString(keyEvent->key(), keyEvent->modifiers()) << ")";
+        }
+        return true;
+    case ShortcutTable::Action::Quit:
+        // Keys belong to the password dialog itself while it is open
+        if (QApplication::activeModalWidget()) {
+            break;
+        }
+        if (!keyEvent->isAutoRepeat()) {
+            emit quitRequested();
+        }
+        return true;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+bool KeyboardLockdown::nativeEventFilter(const QByteArray& eventType, void* message, qintptr* result) {
+    Q_UNUSED(result);
+#ifdef SEB_HAVE_X11
+    if (eventType != "xcb_generic_event_t" || m_grabs.isEmpty()) {
+        return false;
+    }
+
+    // Our root window grabs: no Qt window to deliver to, swallow them here
+    const xcb_generic_event_t* event = static_cast<const xcb_generic_event_t*>(message);
+    const uint8_t type = event->response_type & ~0x80;
+    if (type == XCB_KEY_PRESS || type == XCB_KEY_RELEASE) {
+        const xcb_key_press_event_t* keyEvent = reinterpret_cast<const xcb_key_press_event_t*>(event);
+        if (keyEvent->event == m_rootWindow) {
+            if (type == XCB_KEY_PRESS) {
+                qCWarning(core::lcWindow) << "Grabbed shortcut blocked (keycode" << keyEvent->detail
+                                          << "state" << keyEvent->state << ")";
+            }
+            return true;
+        }
+    }
+#else
+    Q_UNUSED(eventType);
+    Q_UNUSED(message);
+#endif
+    return false;
+}
+
+void KeyboardLockdown::grabX11Keys() {
+#ifdef SEB_HAVE_X11
+    auto* x11 = qGuiApp->nativeInterface<QNativeInterface::QX11Application>();
+    Display* display = x11 ? x11->display() : nullptr;
+    if (!display) {
+        qCWarning(core::lcWindow) << "No X11 display, shortcuts are only blocked inside the window";
+        return;
+    }
+
+    const Window root = DefaultRootWindow(display);
+    m_rootWindow = root;
+
+    // Caps Lock and Num Lock must not defeat a grab
+    const unsigned int lockVariants[] = {0, LockMask, Mod2Mask, LockMask | Mod2Mask};
+    const Qt::KeyboardModifier extras[] = {
+        Qt::ControlModifier, Qt::ShiftModifier, Qt::AltModifier, Qt::MetaModifier
+    };
+
+    grabFailed = false;
+    XErrorHandler previousHandler = XSetErrorHandler(recordGrabError);
+
+    for (const ShortcutTable::Entry& entry : m_table.entries()) {
+        if (entry.action != ShortcutTable::Action::Block) {
+            continue;
+        }
+        const KeySym keysym = keysymFor(entry.key);
+        const KeyCode keycode = keysym == NoSymbol ? 0 : XKeysymToKeycode(display, keysym);
+        if (keycode == 0) {
+            continue; // Still blocked inside the window by the event filter
+        }
+
+        // Same superset semantics as the table, unless a more specific
+        // rule maps the combination to something else
+        for (int mask = 0; mask < 16; ++mask) {
+            Qt::KeyboardModifiers combination = entry.modifiers;
+            for (int bit = 0; bit < 4; ++bit) {
+                if (mask & (1 << bit)) {
+                    combination |= extras[bit];
+                }
+            }
+            if ((mask != 0 && combination == entry.modifiers)
+                || m_table.lookup(entry.key, combination) != ShortcutTable::Action::Block) {
+                continue;
+            }
+            for (unsigned int lock : lockVariants) {
+                const unsigned int modifiers = x11Modifiers(combination) | lock;
+                XGrabKey(display, keycode, modifiers, root, True, GrabModeAsync, GrabModeAsync);
+                m_grabs.append(X11Grab{keycode, modifiers});
+            }
+        }
+    }
+
+    XSync(display, False);
+    XSetErrorHandler(previousHandler);
+
+    if (grabFailed) {
+        qCWarning(core::lcWindow) << "Some shortcuts are grabbed by another client (window manager?);"
+                                  << "they are only blocked inside the window";
+    }
+    qCDebug(core::lcWindow) << "X11 key grabs:" << m_grabs.size();
+#endif
+}
+
+void KeyboardLockdown::ungrabX11Keys() {
+#ifdef SEB_HAVE_X11
+    if (m_grabs.isEmpty()) {
+        return;
+    }
+    auto* x11 = qGuiApp->nativeInterface<QNativeInterface::QX11Application>();
+    Display* display = x11 ? x11->display() : nullptr;
+    if (!display) {
+        return;
+    }
+    for (const X11Grab& grab : std::as_const(m_grabs)) {
+        XUngrabKey(display, grab.keycode, grab.modifiers, m_rootWindow);
+    }
+    XFlush(display);
+    m_grabs.clear();
+#endif
+}
+
+} // namespace web
+} // namespace seb
@@ -0,0 +1,54 @@
+#ifndef SEB_WEB_KEYBOARD_LOCKDOWN_H
+#define SEB_WEB_KEYBOARD_LOCKDOWN_H
+
+#include <QtCore/QAbstractNativeEventFilter>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include "ShortcutTable.h"
+
+namespace seb {
+namespace web {
+
+// Applies a ShortcutTable to the whole application.
+//
+// An application-wide event filter sees every key press before the
+// receiving widget, including Chromium's focus proxy inside QWebEngineView,
+// so blocked combinations never reach the page. On X11 the blocked
+// combinations are additionally grabbed on the root window (XGrabKey), which
+// takes them away from other clients while the exam runs; a native event
+// filter swallows the grabbed key events.
+class KeyboardLockdown : public QObject, public QAbstractNativeEventFilter {
+    Q_OBJECT
+
+public:
+    explicit KeyboardLockdown(const ShortcutTable& table, QObject* parent = nullptr);
+    ~KeyboardLockdown() override;
+
+    void install();
+
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    bool nativeEventFilter(const QByteArray& eventType, void* message, qintptr* result) override;
+
+signals:
+    // A quit shortcut was pressed outside of a modal dialog
+    void quitRequested();
+
+private:
+    void grabX11Keys();
+    void ungrabX11Keys();
+
+    struct X11Grab {
+        int keycode;
+        unsigned int modifiers;
+    };
+
+    ShortcutTable m_table;
+    bool m_installed;
+    unsigned long m_rootWindow;
+    QList<X11Grab> m_grabs;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_KEYBOARD_LOCKDOWN_H
@@ -1,15 +1,29 @@
 #include "MainWindow.h"
+#include "AssetPrefetcher.h"
+#include "KeyboardLockdown.h"
 #include "RequestInterceptor.h"
+#include "SebSchemeHandler.h"
 #include "SecureWebEnginePage.h"
+#include "StartLoadController.h"
+#include "UserScripts.h"
+#include "WaylandLockdown.h"
+#include "../core/AuditLog.h"
 #include "../core/Config.h"
 #include "../core/IdleInhibitor.h"
+#include "../core/Logging.h"
+#include "../core/MetricsExporter.h"
+#include "../core/PolicyStore.h"
+#include "../core/PolicyWatcher.h"
+#include "../core/ResourceProfile.h"
+#include "../core/StartupTrace.h"
 #include <QtWebEngineWidgets/QWebEngineView>
 #include <QtWebEngineCore/QWebEngineProfile>
 #include <QtWebEngineCore/QWebEngineDownloadRequest>
 #include <QtWebEngineCore/QWebEngineSettings>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
+#include <QtCore/QVariant>
 #include <QtCore/QDebug>
-#include <QtGui/QKeyEvent>
 #include <QtGui/QCloseEvent>
 #include <QtWidgets/QInputDialog>
 #include <QtWidgets/QMessageBox>
@@ -22,20 +36,19 @@ MainWindow::MainWindow(const core::Policy& policy, const QString& quitPassword,
     , m_webView(nullptr)
     , m_profile(nullptr)
     , m_interceptor(nullptr)
+    , m_startLoadController(nullptr)
     , m_policy(policy)
     , m_idleInhibitor(nullptr)
     , m_quitPassword(quitPassword)
     , m_passwordVerified(false)
-    , m_isX11(false)
+    , m_keyboardLockdown(nullptr)
+    , m_loadStartUs(0)
+    , m_firstLoadTraced(false)
 {
-    // Detect X11 session
-    m_isX11 = isX11Session();
-    if (m_isX11) {
-        qDebug() << "X11 session detected - enabling shortcut suppression";
-    }
+    using core::StartupTrace;
     
     if (!m_quitPassword.isEmpty()) {
-        qDebug() << "Quit password protection enabled";
+        qCDebug(core::lcWindow) << "Quit password protection enabled";
     }
     
     // Create idle inhibitor
@@ -45,23 +58,81 @@ MainWindow::MainWindow(const core::Policy& policy, const QString& quitPassword,
     setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
     
     // Create dedicated profile
-    m_profile = new QWebEngineProfile("SEBProfile", this);
+    {
+        StartupTrace::Span span("QWebEngineProfile");
+        m_profile = new QWebEngineProfile("SEBProfile", this);
+    }
+
+    // Internal pages (block page, waiting page) come from seb://
+    m_profile->installUrlSchemeHandler(SebSchemeHandler::SchemeName, new SebSchemeHandler(this));
+
+    // Cap the HTTP disk cache for low-memory machines
+    if (m_policy.resources.httpCacheMb > 0) {
+        m_profile->setHttpCacheMaximumSize(m_policy.resources.httpCacheMb * 1024 * 1024);
+    }
     
     // Setup web engine
-    setupWebEngine();
+    {
+        StartupTrace::Span span("MainWindow::setupWebEngine");
+        setupWebEngine();
+    }
+    
+    // Periodic per-process memory report to compare resource profiles
+    if (m_policy.resources.memoryReportIntervalMs > 0) {
+        QTimer* memoryReport = new QTimer(this);
+        memoryReport->setInterval(m_policy.resources.memoryReportIntervalMs);
+        connect(memoryReport, &QTimer::timeout, this, []() {
+            qCInfo(core::lcResources).noquote() << core::ResourceProfile::memoryReport();
+        });
+        memoryReport->start();
+    }
+    
+    // Export counters and latency histograms if configured
+    if (m_policy.metrics.isEnabled()) {
+        core::MetricsExporter* exporter = new core::MetricsExporter(m_policy.metrics, this);
+        exporter->start();
+    }
     
     // Load start URL
-    loadStartUrl();
+    {
+        StartupTrace::Span span("MainWindow::loadStartUrl");
+        loadStartUrl();
+    }
+    
+    // Warm the HTTP cache in the background once the start page is up, so
+    // the prefetch does not compete with the start page load
+    if (m_policy.prefetch.isEnabled() && m_startLoadController) {
+        AssetPrefetcher* prefetcher = new AssetPrefetcher(m_profile, m_policy.prefetch, m_policy.startUrl, this);
+        connect(m_startLoadController, &StartLoadController::finished, prefetcher, [prefetcher](bool ok) {
+            if (ok) {
+                prefetcher->start();
+            }
+        });
+    }
     
     // Start idle inhibition
-    m_idleInhibitor->start();
+    {
+        StartupTrace::Span span("IdleInhibitor::start");
+        m_idleInhibitor->start();
+    }
     
     // Show fullscreen
-    showFullScreen();
+    {
+        StartupTrace::Span span("showFullScreen");
+        showFullScreen();
+    }
     
-    // Setup X11 key grabs if on X11
-    if (m_isX11) {
-        setupX11KeyGrabs();
+    // Block shortcuts before Chromium sees them (and grab them on X11)
+    m_keyboardLockdown = new KeyboardLockdown(
+        ShortcutTable::build(m_policy.blockedShortcuts, !m_quitPassword.isEmpty()), this);
+    connect(m_keyboardLockdown, &KeyboardLockdown::quitRequested,
+            this, &MainWindow::requestQuit, Qt::QueuedConnection);
+    m_keyboardLockdown->install();
+
+    // On Wayland, have the compositor hand its shortcuts to the window
+    if (WaylandLockdown::isSupported()) {
+        WaylandLockdown* waylandLockdown = new WaylandLockdown(windowHandle(), this);
+        waylandLockdown->start();
     }
 }
 
@@ -69,28 +140,52 @@ MainWindow::~MainWindow() {
     // Qt will clean up child objects
 }
 
+void MainWindow::watchPolicyFile(const QString& configPath) {
+    core::PolicyWatcher* watcher = new core::PolicyWatcher(configPath, m_policy, m_policyStore, this);
+    watcher->start();
+}
+
 void MainWindow::setupWebEngine() {
     // Set user agent with suffix if configured
     if (!m_policy.userAgentSuffix.isEmpty()) {
         QString currentUA = m_profile->httpUserAgent();
         QString newUA = currentUA + " " + m_policy.userAgentSuffix;
         m_profile->setHttpUserAgent(newUA);
-        qDebug() << "User-Agent set to:" << newUA;
+        qCDebug(core::lcWindow) << "User-Agent set to:" << newUA;
     }
     
+    // Compile the allowlist and URL filter once; the snapshot is shared by the
+    // interceptor and the page and replaced as a whole on policy reload
+    auto snapshot = std::make_unique<const core::PolicySnapshot>(m_policy);
+    if (!snapshot->urlFilter().isValid()) {
+        // An empty filter would let every blocked URL through
+        m_startupError = snapshot->urlFilter().errorString();
+    }
+    m_policyStore = QSharedPointer<core::PolicyStore>::create(std::move(snapshot));
+
+    // Parsed here rather than in ConfigLoader, so seb_core needs no QtGui
+    const QString shortcutError = ShortcutTable::validate(m_policy.blockedShortcuts);
+    if (!shortcutError.isEmpty()) {
+        m_startupError = shortcutError;
+    }
+
     // Create request interceptor
-    m_interceptor = new RequestInterceptor(m_policy, this);
+    m_interceptor = new RequestInterceptor(m_policy, m_policyStore, this);
     m_profile->setUrlRequestInterceptor(m_interceptor);
     
     // Connect to download signal on profile to block downloads
     connect(m_profile, &QWebEngineProfile::downloadRequested, this, [](QWebEngineDownloadRequest* download) {
-        qWarning() << "Download blocked:" << download->url().toString();
+        qCWarning(core::lcWindow) << "Download blocked:" << download->url().toString();
+        core::AuditLog::instance().record(core::AuditLog::Event::DownloadBlocked, download->url());
         download->cancel();
     });
     
+    // Lockdown scripts are injected by WebEngine into every frame
+    UserScripts::install(m_profile, m_policy.lockdown);
+
     // Create secure web page with the profile
     SecureWebEnginePage* page = new SecureWebEnginePage(m_profile, 
-                                                          m_policy.allowedDomains,
+                                                          m_policyStore,
                                                           m_policy.startUrl,
                                                           this);
     
@@ -117,86 +212,51 @@ void MainWindow::setupWebEngine() {
     
     // Set as central widget
     setCentralWidget(m_webView);
-    
-    // Install event filter to block Ctrl+P (print)
-    m_webView->installEventFilter(this);
 }
 
 void MainWindow::loadStartUrl() {
-    if (!m_policy.isValid()) {
-        qWarning() << "Invalid policy, cannot load start URL";
+    if (!m_policy.isValid() || !m_startupError.isEmpty()) {
+        qCWarning(core::lcWindow) << "Invalid policy, cannot load start URL";
         return;
     }
     
     QUrl url(m_policy.startUrl);
-    qDebug() << "Loading start URL:" << url.toString();
-    m_webView->setUrl(url);
-}
+    qCDebug(core::lcWindow) << "Loading start URL:" << url.toString();
 
-bool MainWindow::eventFilter(QObject* obj, QEvent* event) {
-    if (event->type() == QEvent::KeyPress) {
-        QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
-        
-        // Block Ctrl+P (print) and Ctrl+S (save) on all platforms
-        if (keyEvent->modifiers() & Qt::ControlModifier) {
-            if (keyEvent->key() == Qt::Key_P) {
-                qWarning() << "Print blocked (Ctrl+P)";
-                return true; // Block the event
-            }
-            if (keyEvent->key() == Qt::Key_S) {
-                qWarning() << "Save blocked (Ctrl+S)";
-                return true; // Block the event
-            }
-        }
-        
-        // X11-specific shortcut blocking
-        if (m_isX11) {
-            Qt::KeyboardModifiers mods = keyEvent->modifiers();
-            int key = keyEvent->key();
-            
-            // Ctrl+L (address bar)
-            if ((mods & Qt::ControlModifier) && key == Qt::Key_L) {
-                qWarning() << "Shortcut blocked (Ctrl+L)";
-                return true;
-            }
-            
-            // Ctrl+T (new tab)
-            if ((mods & Qt::ControlModifier) && key == Qt::Key_T) {
-                qWarning() << "Shortcut blocked (Ctrl+T)";
-                return true;
-            }
-            
-            // Ctrl+N (new window)
-            if ((mods & Qt::ControlModifier) && key == Qt::Key_N) {
-                qWarning() << "Shortcut blocked (Ctrl+N)";
-                return true;
-            }
-            
-            // Ctrl+W (close tab/window)
-            if ((mods & Qt::ControlModifier) && key == Qt::Key_W) {
-                qWarning() << "Shortcut blocked (Ctrl+W)";
-                return true;
-            }
-            
-            // Ctrl+Shift+I (developer tools)
-            if ((mods & (Qt::ControlModifier | Qt::ShiftModifier)) == (Qt::ControlModifier | Qt::ShiftModifier) && key == Qt::Key_I) {
-                qWarning() << "Shortcut blocked (Ctrl+Shift+I)";
-                return true;
-            }
-            
-            // F11 (fullscreen toggle)
-            if (key == Qt::Key_F11) {
-                qWarning() << "Shortcut blocked (F11)";
-                return true;
-            }
-        }
+    // Spreads the initial load and retries it while the server is overloaded
+    m_startLoadController = new StartLoadController(m_webView->page(), url, m_policy.startLoad, this);
+
+    if (core::StartupTrace::instance().isEnabled()) {
+        m_loadStartUs = core::StartupTrace::instance().now();
+        connect(m_startLoadController, &StartLoadController::finished, this, &MainWindow::traceFirstLoad);
     }
-    return QMainWindow::eventFilter(obj, event);
+
+    m_startLoadController->start();
 }
 
-bool MainWindow::isX11Session() const {
-    QString sessionType = qEnvironmentVariable("XDG_SESSION_TYPE");
-    return sessionType.toLower() == "x11";
+void MainWindow::traceFirstLoad(bool ok) {
+    if (m_firstLoadTraced) {
+        return;
+    }
+    m_firstLoadTraced = true;
+
+    core::StartupTrace& trace = core::StartupTrace::instance();
+    trace.addSpan(ok ? "firstLoad" : "firstLoad (failed)", m_loadStartUs, trace.now());
+
+    // First contentful paint as reported by the page, in wall-clock ms
+    m_webView->page()->runJavaScript(
+        "(function() {"
+        "  var entry = performance.getEntriesByName('first-contentful-paint')[0];"
+        "  return entry ? performance.timeOrigin + entry.startTime : 0;"
+        "})()",
+        [](const QVariant& result) {
+            core::StartupTrace& trace = core::StartupTrace::instance();
+            double paintEpochMs = result.toDouble();
+            if (paintEpochMs > 0) {
+                trace.addInstant("firstContentfulPaint", trace.fromEpochMs(paintEpochMs));
+            }
+            trace.finish();
+        });
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
@@ -213,79 +273,11 @@ void MainWindow::closeEvent(QCloseEvent* event) {
     QMainWindow::closeEvent(event);
 }
 
-void MainWindow::keyPressEvent(QKeyEvent* event) {
-    Qt::KeyboardModifiers mods = event->modifiers();
-    int key = event->key();
-    
-    // Handle quit password for Esc and Ctrl+Q
-    if (!m_quitPassword.isEmpty()) {
-        // Esc key
-        if (key == Qt::Key_Escape) {
-            if (promptQuitPassword()) {
-                m_passwordVerified = true; // Mark as verified
-                close(); // Will trigger closeEvent, but password already verified
-            }
-            event->accept();
-            return;
-        }
-        
-        // Ctrl+Q
-        if ((mods & Qt::ControlModifier) && key == Qt::Key_Q) {
-            if (promptQuitPassword()) {
-                m_passwordVerified = true; // Mark as verified
-                close(); // Will trigger closeEvent, but password already verified
-            }
-            event->accept();
-            return;
-        }
+void MainWindow::requestQuit() {
+    if (promptQuitPassword()) {
+        m_passwordVerified = true; // Mark as verified
+        close(); // Will trigger closeEvent, but password already verified
     }
-    
-    // X11-specific shortcut blocking at window level
-    if (m_isX11) {
-        // Ctrl+L (address bar)
-        if ((mods & Qt::ControlModifier) && key == Qt::Key_L) {
-            qWarning() << "Shortcut blocked (Ctrl+L)";
-            event->accept();
-            return;
-        }
-        
-        // Ctrl+T (new tab)
-        if ((mods & Qt::ControlModifier) && key == Qt::Key_T) {
-            qWarning() << "Shortcut blocked (Ctrl+T)";
-            event->accept();
-            return;
-        }
-        
-        // Ctrl+N (new window)
-        if ((mods & Qt::ControlModifier) && key == Qt::Key_N) {
-            qWarning() << "Shortcut blocked (Ctrl+N)";
-            event->accept();
-            return;
-        }
-        
-        // Ctrl+W (close tab/window)
-        if ((mods & Qt::ControlModifier) && key == Qt::Key_W) {
-            qWarning() << "Shortcut blocked (Ctrl+W)";
-            event->accept();
-            return;
-        }
-        
-        // Ctrl+Shift+I (developer tools)
-        if ((mods & (Qt::ControlModifier | Qt::ShiftModifier)) == (Qt::ControlModifier | Qt::ShiftModifier) && key == Qt::Key_I) {
-            qWarning() << "Shortcut blocked (Ctrl+Shift+I)";
-            event->accept();
-            return;
-        }
-        
-        // F11 (fullscreen toggle)
-        if (key == Qt::Key_F11) {
-            qWarning() << "Shortcut blocked (F11)";
-            event->accept();
-            return;
-        }
-    }
-    
-    QMainWindow::keyPressEvent(event);
 }
 
 bool MainWindow::promptQuitPassword() const {
@@ -320,13 +312,6 @@ bool MainWindow::promptQuitPassword() const {
     return true;
 }
 
-void MainWindow::setupX11KeyGrabs() {
-    // XGrabKey implementation can be added here for stronger blocking
-    // This would require libX11 and the window to be visible first
-    // For now, the eventFilter and keyPressEvent provide sufficient blocking
-    qDebug() << "X11 key grabs - using eventFilter and keyPressEvent for shortcut blocking";
-}
-
 } // namespace web
 } // namespace seb
 
@@ -4,18 +4,22 @@
 #include <QtWidgets/QMainWindow>
 #include <QtWebEngineWidgets/QWebEngineView>
 #include <QtWebEngineCore/QWebEngineProfile>
+#include <QtCore/QSharedPointer>
 #include "../core/Config.h"
 
 namespace seb {
 namespace core {
     struct Policy;
     class IdleInhibitor;
+    class PolicyStore;
 }
 
 namespace web {
 
+class KeyboardLockdown;
 class RequestInterceptor;
 class SecureWebEnginePage;
+class StartLoadController;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -24,27 +28,38 @@ public:
     explicit MainWindow(const core::Policy& policy, const QString& quitPassword = QString(), QWidget* parent = nullptr);
     ~MainWindow() override;
 
+    // Apply allowlist / URL filter changes of the configuration file live
+    void watchPolicyFile(const QString& configPath);
+
+    // Why the window cannot enforce the policy; empty if it can
+    QString startupError() const { return m_startupError; }
+
 protected:
     void closeEvent(QCloseEvent* event) override;
-    bool eventFilter(QObject* obj, QEvent* event) override;
-    void keyPressEvent(QKeyEvent* event) override;
+
+private slots:
+    void traceFirstLoad(bool ok);
+    void requestQuit();
 
 private:
     void setupWebEngine();
     void loadStartUrl();
-    bool isX11Session() const;
-    void setupX11KeyGrabs();
 
     bool promptQuitPassword() const;
 
     QWebEngineView* m_webView;
     QWebEngineProfile* m_profile;
     RequestInterceptor* m_interceptor;
+    StartLoadController* m_startLoadController;
     core::Policy m_policy;
+    QSharedPointer<core::PolicyStore> m_policyStore;
     core::IdleInhibitor* m_idleInhibitor;
     QString m_quitPassword;
     bool m_passwordVerified;
-    bool m_isX11;
+    KeyboardLockdown* m_keyboardLockdown;
+    qint64 m_loadStartUs;
+    bool m_firstLoadTraced;
+    QString m_startupError;
 };
 
 } // namespace web
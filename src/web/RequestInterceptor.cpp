@@ -1,62 +1,142 @@
 #include "RequestInterceptor.h"
+#include "SebSchemeHandler.h"
+#include "../core/AuditLog.h"
 #include "../core/Config.h"
+#include "../core/Logging.h"
+#include "../core/Metrics.h"
+#include "../core/PolicyBlob.h"
 #include <QtWebEngineCore/QWebEngineUrlRequestInfo>
-#include <QtCore/QUrl>
 #include <QtCore/QDebug>
+#include <chrono>
 
 namespace seb {
 namespace web {
 
-RequestInterceptor::RequestInterceptor(const core::Policy& policy, QObject* parent)
+namespace {
+
+class WebEngineRequest final : public InterceptedRequest {
+public:
+    explicit WebEngineRequest(QWebEngineUrlRequestInfo& info) : m_info(info) {}
+
+    QUrl requestUrl() const override { return m_info.requestUrl(); }
+    QUrl firstPartyUrl() const override { return m_info.firstPartyUrl(); }
+    int resourceType() const override { return int(m_info.resourceType()); }
+    void block(bool shouldBlock) override { m_info.block(shouldBlock); }
+    void setHttpHeader(const QByteArray& name, const QByteArray& value) override {
+        m_info.setHttpHeader(name, value);
+    }
+
+private:
+    QWebEngineUrlRequestInfo& m_info;
+};
+
+} // namespace
+
+RequestInterceptor::RequestInterceptor(const core::Policy& policy,
+                                       QSharedPointer<core::PolicyStore> policyStore,
+                                       QObject* parent)
     : QWebEngineUrlRequestInterceptor(parent)
-    , m_allowedDomains(policy.allowedDomains)
-    , m_configKey("stub-value")
-    , m_clientVersion(policy.getClientVersion())
-    , m_clientType(policy.getClientType())
-    , m_sendConfigKey(policy.sendConfigKey)
+    , m_policyStore(std::move(policyStore))
+    , m_compiled(policy.compiled)
+    , m_headers(encodeHeaders(policy))
+    , m_hasher(policy.browserExamKey, policy.sendConfigKey ? policy.configKey : QString())
+    , m_blockedHosts(std::make_unique<core::LogThrottle>())
 {
 }
 
+RequestInterceptor::~RequestInterceptor() {
+    const core::PolicyStore::CacheStats stats = m_policyStore->verdictCacheStats();
+    core::PolicyStore::Reader snapshot = m_policyStore->read();
+    qCDebug(core::lcRequest) << "Host verdict cache: hits" << stats.hits
+             << "misses" << stats.misses
+             << "capacity" << snapshot->verdictCache().capacity();
+}
+
 void RequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo& info) {
+    WebEngineRequest request(info);
+    handleRequest(request);
+}
+
+void RequestInterceptor::handleRequest(InterceptedRequest& info) {
+    const auto start = std::chrono::steady_clock::now();
+    auto recordLatency = [&info, start](bool blocked) {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        core::Metrics::instance().recordRequest(blocked, info.resourceType(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    };
+
     QUrl url = info.requestUrl();
-    QString host = url.host();
 
-    // Check if domain is allowed
-    if (!isDomainAllowed(host)) {
-        qWarning() << "Blocking request to non-allowed domain:" << host;
+    auto blockRequest = [this, &info, &url, &recordLatency](const char* message) {
+        // Pages retry blocked trackers constantly; log 1, 2, 4, ... occurrences per host
+        const QString host = url.host(QUrl::FullyEncoded);
+        const quint64 count = m_blockedHosts->record(host);
+        if (count == 1) {
+            qCWarning(core::lcRequest) << message << url.toString(QUrl::RemoveQuery);
+        } else if (count > 1) {
+            qCWarning(core::lcRequest).noquote() << "Blocked host" << host << count << "times";
+        }
+        core::AuditLog::instance().record(core::AuditLog::Event::RequestBlocked, url,
+                                          quint8(info.resourceType()));
         info.block(true);
+        recordLatency(true);
+    };
+
+    // Internal pages get neither policy checks nor exam headers; other
+    // seb:// URLs are not served and never reach the network either
+    if (url.scheme() == QLatin1String(SebSchemeHandler::SchemeName)) {
+        if (!SebSchemeHandler::isServed(url)) {
+            blockRequest("Blocking request to unknown internal page:");
+            return;
+        }
+        recordLatency(false);
         return;
     }
 
-    // Inject SEB headers
-    info.setHttpHeader("X-SafeExamBrowser", QByteArray("SEB-Linux-MVP"));
-    
-    // SEB standard headers (with values from config or defaults)
-    info.setHttpHeader("X-SafeExamBrowser-RequestHash", QByteArray("placeholder-stub-request-hash"));
-    info.setHttpHeader("X-SafeExamBrowser-ClientVersion", m_clientVersion.toUtf8());
-    info.setHttpHeader("X-SafeExamBrowser-ClientType", m_clientType.toUtf8());
-    info.setHttpHeader("X-SafeExamBrowser-ConfigVersion", QByteArray("2"));
-    
-    // Optional config key header (if enabled in policy)
-    if (m_sendConfigKey) {
-        info.setHttpHeader("X-SafeExamBrowser-ConfigKey", m_configKey.toUtf8());
+    // One snapshot for the whole decision, even across a policy reload
+    const core::PolicyStore::Reader snapshot = m_policyStore->read();
+
+    // Check URL filter rules and the domain allowlist of the current snapshot
+    if (!snapshot->isUrlAllowed(url)) {
+        blockRequest("Blocking request to non-allowed URL:");
+        return;
+    }
+
+    // Per resource type rules; main frame navigations are left to the checks above
+    const core::ResourceRuleTable& resourceRules = snapshot->resourceRules();
+    if (!resourceRules.isEmpty() && info.resourceType() != core::ResourceType::MainFrame
+        && resourceRules.evaluate(info.resourceType(), url.host(QUrl::FullyEncoded),
+                                  info.firstPartyUrl().host(QUrl::FullyEncoded))
+               == core::ResourceRuleTable::Verdict::Block) {
+        blockRequest("Blocking request by resource rule:");
+        return;
     }
-}
 
-bool RequestInterceptor::isDomainAllowed(const QString& host) const {
-    // Check exact match
-    if (m_allowedDomains.contains(host)) {
-        return true;
+    // Inject SEB headers (implicitly shared, no per-request encoding)
+    for (const auto& header : m_headers) {
+        info.setHttpHeader(header.first, header.second);
     }
 
-    // Check subdomain match (e.g., "cdn.example.com" matches "example.com")
-    for (const QString& allowedDomain : m_allowedDomains) {
-        if (host == allowedDomain || host.endsWith("." + allowedDomain)) {
-            return true;
+    // Verification hashes over the absolute URL without fragment
+    if (m_hasher.isEnabled()) {
+        core::RequestHasher::Hashes hashes = m_hasher.hashesFor(url.toEncoded(QUrl::RemoveFragment));
+        if (!hashes.requestHash.isEmpty()) {
+            info.setHttpHeader(QByteArrayLiteral("X-SafeExamBrowser-RequestHash"), hashes.requestHash);
+        }
+        if (!hashes.configKeyHash.isEmpty()) {
+            info.setHttpHeader(QByteArrayLiteral("X-SafeExamBrowser-ConfigKeyHash"), hashes.configKeyHash);
         }
     }
 
-    return false;
+    recordLatency(false);
+}
+
+core::HeaderList RequestInterceptor::encodeHeaders(const core::Policy& policy) {
+    // Precompiled headers share the mapped blob
+    if (policy.compiled) {
+        return policy.compiled->headers();
+    }
+    return core::RequestHeaders::encode(policy);
 }
 
 } // namespace web
@@ -2,31 +2,73 @@
 #define SEB_WEB_REQUEST_INTERCEPTOR_H
 
 #include <QtWebEngineCore/QWebEngineUrlRequestInterceptor>
-#include <QtCore/QStringList>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <memory>
+#include "../core/PolicyStore.h"
+#include "../core/RequestHasher.h"
+#include "../core/RequestHeaders.h"
 
 namespace seb {
+
 namespace core {
-    struct Policy;
+class LogThrottle;
 }
 
 namespace web {
 
+// The parts of QWebEngineUrlRequestInfo the interceptor uses; lets the
+// benchmarks drive handleRequest() without Qt WebEngine
+class InterceptedRequest {
+public:
+    virtual ~InterceptedRequest() = default;
+
+    virtual QUrl requestUrl() const = 0;
+    virtual QUrl firstPartyUrl() const = 0;
+    virtual int resourceType() const = 0;
+    virtual void block(bool shouldBlock) = 0;
+    virtual void setHttpHeader(const QByteArray& name, const QByteArray& value) = 0;
+};
+
 class RequestInterceptor : public QWebEngineUrlRequestInterceptor {
     Q_OBJECT
 
 public:
-    explicit RequestInterceptor(const core::Policy& policy, QObject* parent = nullptr);
+    explicit RequestInterceptor(const core::Policy& policy,
+                                QSharedPointer<core::PolicyStore> policyStore,
+                                QObject* parent = nullptr);
+    ~RequestInterceptor() override;
 
     void interceptRequest(QWebEngineUrlRequestInfo& info) override;
 
+    // Request handling shared by interceptRequest() and the benchmarks
+    void handleRequest(InterceptedRequest& info);
+
+    // Host verdict cache statistics of the current policy snapshot
+    quint64 cacheHits() const { return m_policyStore->read()->verdictCache().hits(); }
+    quint64 cacheMisses() const { return m_policyStore->read()->verdictCache().misses(); }
+
 private:
-    bool isDomainAllowed(const QString& host) const;
-    
-    QStringList m_allowedDomains;
-    QString m_configKey;
-    QString m_clientVersion;
-    QString m_clientType;
-    bool m_sendConfigKey;
+    static core::HeaderList encodeHeaders(const core::Policy& policy);
+
+    // Allowlist, URL filter and resource rules; swapped on policy reload
+    QSharedPointer<core::PolicyStore> m_policyStore;
+
+    // Keeps precompiled header bytes mapped (null unless loaded from a blob)
+    std::shared_ptr<const core::PolicyBlob> m_compiled;
+
+    // Encoded once from the policy; injected by sharing the buffers
+    core::HeaderList m_headers;
+
+    // Per-request verification hashes
+    core::RequestHasher m_hasher;
+
+    // Duplicate suppression for blocked-request warnings
+    std::unique_ptr<core::LogThrottle> m_blockedHosts;
 };
 
 } // namespace web
@@ -0,0 +1,132 @@
+#include "SebSchemeHandler.h"
+#include "../core/Logging.h"
+#include <QtWebEngineCore/QWebEngineUrlRequestJob>
+#include <QtWebEngineCore/QWebEngineUrlScheme>
+#include <QtCore/QBuffer>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <initializer_list>
+#include <utility>
+
+namespace seb {
+namespace web {
+
+namespace {
+
+const struct {
+    const char* key;
+    const char* file;
+    const char* mimeType;
+} ResourceTable[] = {
+    {"blocked", ":/seb/pages/blocked.html", "text/html"},
+    {"waiting", ":/seb/pages/waiting.html", "text/html"},
+    {"error", ":/seb/pages/error.html", "text/html"},
+    {"/assets/seb.css", ":/seb/assets/seb.css", "text/css"},
+};
+
+// Table key of a served URL, or nullptr: a page name as the host with no
+// path, or an asset path below one of the pages
+const char* resourceKey(const QUrl& url) {
+    if (url.scheme() != QLatin1String(SebSchemeHandler::SchemeName)) {
+        return nullptr;
+    }
+    const QString host = url.host();
+    const QString path = url.path();
+    const bool asset = path.startsWith(QLatin1String("/assets/"));
+    if (!asset && !path.isEmpty() && path != QLatin1String("/")) {
+        return nullptr;
+    }
+
+    bool pageHost = false;
+    const char* key = nullptr;
+    for (const auto& entry : ResourceTable) {
+        const bool page = entry.key[0] != '/';
+        pageHost = pageHost || (page && host == QLatin1String(entry.key));
+        if (asset ? path == QLatin1String(entry.key) : (page && host == QLatin1String(entry.key))) {
+            key = entry.key;
+        }
+    }
+    return pageHost ? key : nullptr;
+}
+
+// seb://<page>?key=value&...; values are fully percent-encoded so that
+// '+', '&' and '#' in URLs survive URLSearchParams on the page
+QUrl pageUrl(const char* page, std::initializer_list<std::pair<const char*, QString>> params) {
+    QByteArray query;
+    for (const auto& param : params) {
+        if (!query.isEmpty()) {
+            query += '&';
+        }
+        query += param.first;
+        query += '=';
+        query += QUrl::toPercentEncoding(param.second);
+    }
+
+    QUrl url;
+    url.setScheme(QLatin1String(SebSchemeHandler::SchemeName));
+    url.setHost(QLatin1String(page));
+    url.setQuery(QString::fromLatin1(query), QUrl::StrictMode);
+    return url;
+}
+
+} // namespace
+
+SebSchemeHandler::SebSchemeHandler(QObject* parent)
+    : QWebEngineUrlSchemeHandler(parent)
+{
+    // Decompress once; requests then only share the buffers
+    for (const auto& entry : ResourceTable) {
+        QFile file(QLatin1String(entry.file));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCWarning(core::lcNavigation) << "Missing internal resource" << entry.file;
+            continue;
+        }
+        m_resources.insert(QLatin1String(entry.key), Resource{entry.mimeType, file.readAll()});
+    }
+}
+
+void SebSchemeHandler::registerScheme() {
+    QWebEngineUrlScheme scheme(SchemeName);
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    // Local: web content cannot load or frame the internal pages
+    scheme.setFlags(QWebEngineUrlScheme::SecureScheme | QWebEngineUrlScheme::LocalScheme);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+QUrl SebSchemeHandler::blockPageUrl(const QString& blockedUrl, const QString& backUrl) {
+    return pageUrl("blocked", {{"url", blockedUrl}, {"back", backUrl}});
+}
+
+QUrl SebSchemeHandler::waitingPageUrl(const QString& message, const QUrl& url, int delayMs) {
+    return pageUrl("waiting", {{"message", message}, {"url", url.toString()}, {"delay", QString::number(delayMs)}});
+}
+
+QUrl SebSchemeHandler::errorPageUrl(const QString& message, const QUrl& url) {
+    return pageUrl("error", {{"message", message}, {"url", url.toString()}});
+}
+
+bool SebSchemeHandler::isServed(const QUrl& url) {
+    return resourceKey(url) != nullptr;
+}
+
+void SebSchemeHandler::requestStarted(QWebEngineUrlRequestJob* job) {
+    if (job->requestMethod() != "GET") {
+        job->fail(QWebEngineUrlRequestJob::RequestDenied);
+        return;
+    }
+
+    const char* key = resourceKey(job->requestUrl());
+    auto it = key ? m_resources.constFind(QLatin1String(key)) : m_resources.constEnd();
+    if (it == m_resources.constEnd()) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    QBuffer* buffer = new QBuffer(job);
+    buffer->setData(it->data);
+    buffer->open(QIODevice::ReadOnly);
+    job->reply(it->mimeType, buffer);
+}
+
+} // namespace web
+} // namespace seb
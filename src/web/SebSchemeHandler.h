@@ -0,0 +1,57 @@
+#ifndef SEB_WEB_SEB_SCHEME_HANDLER_H
+#define SEB_WEB_SEB_SCHEME_HANDLER_H
+
+#include <QtWebEngineCore/QWebEngineUrlSchemeHandler>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+namespace seb {
+namespace web {
+
+// Serves the browser's internal pages from the seb:// scheme.
+//
+// Pages and assets are compiled into the binary as Qt resources and read
+// into memory once; each request is answered from a shared buffer. Pages
+// are static and take their parameters from the query string, so nothing
+// is generated per request:
+//   seb://blocked?url=...&back=...       Access Restricted page
+//   seb://waiting?message=...&url=...&delay=...
+//   seb://error?message=...&url=...      Final error, with a retry link
+//   seb://<page>/assets/...              Shared stylesheet
+class SebSchemeHandler : public QWebEngineUrlSchemeHandler {
+    Q_OBJECT
+
+public:
+    static constexpr char SchemeName[] = "seb";
+
+    explicit SebSchemeHandler(QObject* parent = nullptr);
+
+    // Declare the scheme to Chromium; must run before QApplication exists
+    static void registerScheme();
+
+    static QUrl blockPageUrl(const QString& blockedUrl, const QString& backUrl);
+    static QUrl waitingPageUrl(const QString& message, const QUrl& url, int delayMs);
+    static QUrl errorPageUrl(const QString& message, const QUrl& url);
+
+    // Whether url is one of the pages or assets above; the only seb:// URLs
+    // exempt from the navigation and request policy
+    static bool isServed(const QUrl& url);
+
+    void requestStarted(QWebEngineUrlRequestJob* job) override;
+
+private:
+    struct Resource {
+        QByteArray mimeType;
+        QByteArray data;
+    };
+
+    // Keyed by page name ("blocked") or asset path ("/assets/seb.css")
+    QHash<QString, Resource> m_resources;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_SEB_SCHEME_HANDLER_H
@@ -1,4 +1,9 @@
 #include "SecureWebEnginePage.h"
+#include "SebSchemeHandler.h"
+#include "../core/AuditLog.h"
+#include "../core/Logging.h"
+#include "../core/Metrics.h"
+#include "../core/PolicyStore.h"
 #include <QtCore/QDebug>
 #include <QtCore/QUrl>
 
@@ -6,18 +11,20 @@ namespace seb {
 namespace web {
 
 SecureWebEnginePage::SecureWebEnginePage(QWebEngineProfile* profile,
-                                         const QStringList& allowedDomains,
+                                         QSharedPointer<core::PolicyStore> policyStore,
                                          const QString& startUrl,
                                          QObject* parent)
     : QWebEnginePage(profile, parent)
-    , m_allowedDomains(allowedDomains)
+    , m_policyStore(std::move(policyStore))
     , m_startUrl(startUrl)
 {
     // Connect to print signal to block printing
     connect(this, &QWebEnginePage::printRequested, this, &SecureWebEnginePage::handlePrintRequested);
-    
-    // Suppress context menu by disabling it in settings
-    suppressContextMenu();
+
+    connect(this, &QWebEnginePage::loadStarted, this, &SecureWebEnginePage::handleLoadStarted);
+    connect(this, &QWebEnginePage::loadFinished, this, &SecureWebEnginePage::handleLoadFinished);
+    connect(this, &QWebEnginePage::renderProcessTerminated,
+            this, &SecureWebEnginePage::handleRenderProcessTerminated);
 }
 
 bool SecureWebEnginePage::acceptNavigationRequest(const QUrl& url, NavigationType type, bool isMainFrame) {
@@ -26,13 +33,30 @@ bool SecureWebEnginePage::acceptNavigationRequest(const QUrl& url, NavigationTyp
         return QWebEnginePage::acceptNavigationRequest(url, type, isMainFrame);
     }
     
-    // Check if domain is allowed
-    QString host = url.host();
-    if (!host.isEmpty() && !isDomainAllowed(host)) {
-        qWarning() << "Blocking navigation to non-allowed domain:" << host;
+    // Internal pages (block page, waiting page); nothing else under seb://
+    if (url.scheme() == QLatin1String(SebSchemeHandler::SchemeName)) {
+        if (!SebSchemeHandler::isServed(url)) {
+            qCWarning(core::lcNavigation) << "Blocking navigation to unknown internal page:" << url.toString(QUrl::RemoveQuery);
+            core::AuditLog::instance().record(core::AuditLog::Event::NavigationBlocked, url, quint8(type));
+            core::Metrics::instance().recordNavigation(true);
+            return false;
+        }
+        return true;
+    }
+
+    // Check URL filter rules and the domain allowlist
+    QString host = url.host(QUrl::FullyEncoded);
+    if (!host.isEmpty() && !m_policyStore->read()->isUrlAllowed(url)) {
+        qCWarning(core::lcNavigation) << "Blocking navigation to non-allowed URL:" << url.toString(QUrl::RemoveQuery);
+        core::AuditLog::instance().record(core::AuditLog::Event::NavigationBlocked, url, quint8(type));
+        core::Metrics::instance().recordNavigation(true);
         showBlockPage(url.toString());
         return false; // Block the navigation
     }
+    if (!host.isEmpty()) {
+        core::AuditLog::instance().record(core::AuditLog::Event::NavigationAllowed, url, quint8(type));
+        core::Metrics::instance().recordNavigation(false);
+    }
     
     // Allow navigation (RequestInterceptor also blocks at request level)
     return QWebEnginePage::acceptNavigationRequest(url, type, isMainFrame);
@@ -40,154 +64,41 @@ bool SecureWebEnginePage::acceptNavigationRequest(const QUrl& url, NavigationTyp
 
 QWebEnginePage* SecureWebEnginePage::createWindow(WebWindowType type) {
     // Block all popup windows
-    qWarning() << "Popup window blocked";
-    Q_UNUSED(type);
+    qCWarning(core::lcNavigation) << "Popup window blocked";
+    core::AuditLog::instance().record(core::AuditLog::Event::PopupBlocked, url(), quint8(type));
     return nullptr;
 }
 
 void SecureWebEnginePage::handlePrintRequested() {
     // Block printing - do nothing
-    qWarning() << "Print request blocked";
+    qCWarning(core::lcNavigation) << "Print request blocked";
+    core::AuditLog::instance().record(core::AuditLog::Event::PrintBlocked, url());
 }
 
-void SecureWebEnginePage::suppressContextMenu() {
-    // Disable context menu via JavaScript
-    runJavaScript(
-        "document.addEventListener('contextmenu', function(e) { e.preventDefault(); return false; });"
-        "document.addEventListener('selectstart', function(e) { e.preventDefault(); return false; });"
-    );
+void SecureWebEnginePage::handleLoadStarted() {
+    m_loadTimer.start();
 }
 
-void SecureWebEnginePage::showBlockPage(const QString& blockedUrl) {
-    QString html = generateBlockPageHtml(blockedUrl);
-    setHtml(html, QUrl("seb://blocked"));
-}
-
-bool SecureWebEnginePage::isDomainAllowed(const QString& host) const {
-    // Check exact match
-    if (m_allowedDomains.contains(host)) {
-        return true;
-    }
-
-    // Check subdomain match (e.g., "cdn.example.com" matches "example.com")
-    for (const QString& allowedDomain : m_allowedDomains) {
-        if (host == allowedDomain || host.endsWith("." + allowedDomain)) {
-            return true;
-        }
+void SecureWebEnginePage::handleLoadFinished(bool ok) {
+    // Only network loads; the local block/waiting pages are not interesting
+    const QString scheme = url().scheme();
+    if (m_loadTimer.isValid() && (scheme == "https" || scheme == "http")) {
+        core::Metrics::instance().recordLoad(ok ? core::Metrics::LoadResult::Succeeded
+                                                : core::Metrics::LoadResult::Failed,
+                                             m_loadTimer.nsecsElapsed());
     }
+    m_loadTimer.invalidate();
+}
 
-    return false;
+void SecureWebEnginePage::handleRenderProcessTerminated(RenderProcessTerminationStatus status, int exitCode) {
+    qCWarning(core::lcNavigation) << "Renderer process terminated, status" << int(status) << "exit code" << exitCode;
+    core::Metrics::instance().recordRendererTermination(int(status));
 }
 
-QString SecureWebEnginePage::generateBlockPageHtml(const QString& blockedUrl) const {
-    // Simple HTML escaping
-    QString escapedBlockedUrl = blockedUrl;
-    escapedBlockedUrl.replace("&", "&amp;");
-    escapedBlockedUrl.replace("<", "&lt;");
-    escapedBlockedUrl.replace(">", "&gt;");
-    escapedBlockedUrl.replace("\"", "&quot;");
-    escapedBlockedUrl.replace("'", "&#39;");
-    
-    QString escapedStartUrl = m_startUrl;
-    escapedStartUrl.replace("&", "&amp;");
-    escapedStartUrl.replace("<", "&lt;");
-    escapedStartUrl.replace(">", "&gt;");
-    escapedStartUrl.replace("\"", "&quot;");
-    escapedStartUrl.replace("'", "&#39;");
-    
-    return QString(R"(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Access Restricted</title>
-    <style>
-        body {
-            font-family: -apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, Oxygen, Ubuntu, Cantarell, sans-serif;
-            display: flex;
-            justify-content: center;
-            align-items: center;
-            min-height: 100vh;
-            margin: 0;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: #333;
-        }
-        .container {
-            background: white;
-            border-radius: 12px;
-            padding: 40px;
-            max-width: 500px;
-            box-shadow: 0 10px 40px rgba(0, 0, 0, 0.2);
-            text-align: center;
-        }
-        .icon {
-            font-size: 64px;
-            margin-bottom: 20px;
-        }
-        h1 {
-            margin: 0 0 16px 0;
-            color: #2d3748;
-            font-size: 28px;
-            font-weight: 600;
-        }
-        p {
-            margin: 0 0 32px 0;
-            color: #718096;
-            font-size: 16px;
-            line-height: 1.6;
-        }
-        .blocked-url {
-            background: #f7fafc;
-            border: 1px solid #e2e8f0;
-            border-radius: 6px;
-            padding: 12px;
-            margin: 20px 0;
-            font-family: 'Monaco', 'Menlo', monospace;
-            font-size: 14px;
-            color: #c53030;
-            word-break: break-all;
-        }
-        .back-button {
-            background: #667eea;
-            color: white;
-            border: none;
-            border-radius: 6px;
-            padding: 14px 32px;
-            font-size: 16px;
-            font-weight: 600;
-            cursor: pointer;
-            transition: background 0.2s;
-            text-decoration: none;
-            display: inline-block;
-        }
-        .back-button:hover {
-            background: #5568d3;
-        }
-        .back-button:active {
-            background: #4a5bc4;
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="icon">🚫</div>
-        <h1>Access Restricted</h1>
-        <p>This domain is not allowed in the current exam session.</p>
-        <div class="blocked-url">%1</div>
-        <a href="%2" class="back-button" id="backButton">Return to Exam</a>
-    </div>
-    <script>
-        document.getElementById('backButton').addEventListener('click', function(e) {
-            e.preventDefault();
-            window.location.href = '%2';
-        });
-    </script>
-</body>
-</html>
-    )").arg(escapedBlockedUrl, escapedStartUrl);
+void SecureWebEnginePage::showBlockPage(const QString& blockedUrl) {
+    core::Metrics::instance().recordBlockPage();
+    setUrl(SebSchemeHandler::blockPageUrl(blockedUrl, m_startUrl));
 }
 
 } // namespace web
 } // namespace seb
-
@@ -3,10 +3,15 @@
 
 #include <QtWebEngineCore/QWebEnginePage>
 #include <QtWebEngineCore/QWebEngineProfile>
-#include <QtCore/QStringList>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QString>
 
 namespace seb {
+namespace core {
+    class PolicyStore;
+}
+
 namespace web {
 
 class SecureWebEnginePage : public QWebEnginePage {
@@ -14,7 +19,7 @@ class SecureWebEnginePage : public QWebEnginePage {
 
 public:
     explicit SecureWebEnginePage(QWebEngineProfile* profile, 
-                                   const QStringList& allowedDomains,
+                                   QSharedPointer<core::PolicyStore> policyStore,
                                    const QString& startUrl,
                                    QObject* parent = nullptr);
 
@@ -29,14 +34,17 @@ private slots:
     // Block printing
     void handlePrintRequested();
 
+    // Metrics: page load time and renderer crashes
+    void handleLoadStarted();
+    void handleLoadFinished(bool ok);
+    void handleRenderProcessTerminated(RenderProcessTerminationStatus status, int exitCode);
+
 private:
-    void suppressContextMenu();
     void showBlockPage(const QString& blockedUrl);
-    bool isDomainAllowed(const QString& host) const;
-    QString generateBlockPageHtml(const QString& blockedUrl) const;
     
-    QStringList m_allowedDomains;
+    QSharedPointer<core::PolicyStore> m_policyStore;
     QString m_startUrl;
+    QElapsedTimer m_loadTimer;
 };
 
 } // namespace web
@@ -0,0 +1,84 @@
+#include "ShortcutTable.h"
+#include "../core/Logging.h"
+#include <QtGui/QKeySequence>
+#include <QtCore/QDebug>
+
+namespace seb {
+namespace web {
+
+bool ShortcutTable::add(const QString& sequence, Action action) {
+    const QKeySequence keys = QKeySequence::fromString(sequence, QKeySequence::PortableText);
+    if (keys.count() != 1 || keys[0].key() == Qt::Key_unknown) {
+        return false;
+    }
+    add(keys[0].key(), keys[0].keyboardModifiers(), action);
+    return true;
+}
+
+void ShortcutTable::add(int key, Qt::KeyboardModifiers modifiers, Action action) {
+    modifiers &= RelevantModifiers;
+    m_entries.append(Entry{key, modifiers, action});
+
+    const Qt::KeyboardModifier all[] = {
+        Qt::ControlModifier, Qt::ShiftModifier, Qt::AltModifier, Qt::MetaModifier
+    };
+    int specificity = 0;
+    for (Qt::KeyboardModifier modifier : all) {
+        specificity += modifiers.testFlag(modifier) ? 1 : 0;
+    }
+
+    // Every superset of the rule's modifiers, unless a more specific rule
+    // already covers it; of equally specific rules the later one wins
+    for (int mask = 0; mask < 16; ++mask) {
+        Qt::KeyboardModifiers combination = modifiers;
+        for (int bit = 0; bit < 4; ++bit) {
+            if (mask & (1 << bit)) {
+                combination |= all[bit];
+            }
+        }
+        auto it = m_slots.find(hashKey(key, combination));
+        if (it == m_slots.end()) {
+            m_slots.insert(hashKey(key, combination), Slot{action, specificity});
+        } else if (it->specificity <= specificity) {
+            *it = Slot{action, specificity};
+        }
+    }
+}
+
+ShortcutTable::Action ShortcutTable::lookup(int key, Qt::KeyboardModifiers modifiers) const {
+    auto it = m_slots.constFind(hashKey(key, modifiers));
+    return it == m_slots.constEnd() ? Action::None : it->action;
+}
+
+ShortcutTable ShortcutTable::build(const QStringList& blockedShortcuts, bool withQuitShortcuts) {
+    ShortcutTable table;
+    if (withQuitShortcuts) {
+        // Only with a modifier: plain Esc belongs to the page (dialogs, editors)
+        table.add(Qt::Key_Q, Qt::ControlModifier, Action::Quit);
+    }
+    for (const QString& shortcut : blockedShortcuts) {
+        // MainWindow refuses to start with invalid entries
+        if (!table.add(shortcut, Action::Block)) {
+            qCWarning(core::lcWindow) << "Ignoring invalid shortcut" << shortcut;
+        }
+    }
+    return table;
+}
+
+QString ShortcutTable::validate(const QStringList& blockedShortcuts) {
+    for (const QString& shortcut : blockedShortcuts) {
+        ShortcutTable table;
+        if (!table.add(shortcut, Action::Block)) {
+            return QString("Field 'blockedShortcuts' contains an invalid key combination: %1").arg(shortcut);
+        }
+    }
+    return QString();
+}
+
+QString ShortcutTable::toString(int key, Qt::KeyboardModifiers modifiers) {
+    return QKeySequence(QKeyCombination(modifiers & RelevantModifiers, Qt::Key(key)))
+        .toString(QKeySequence::PortableText);
+}
+
+} // namespace web
+} // namespace seb
@@ -0,0 +1,70 @@
+#ifndef SEB_WEB_SHORTCUT_TABLE_H
+#define SEB_WEB_SHORTCUT_TABLE_H
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace seb {
+namespace web {
+
+// Key + modifier lookup table for shortcut handling, built once from the
+// policy. A rule also matches when extra modifiers are held (a rule for
+// Ctrl+T catches Ctrl+Shift+T) and the most specific rule wins; the
+// supersets are expanded when the rule is added, so lookup() is a single
+// hash probe regardless of the rule count.
+class ShortcutTable {
+public:
+    enum class Action {
+        None,
+        Block,                     // Swallow the key event
+        Quit                       // Start the quit (password) flow
+    };
+
+    struct Entry {
+        int key;
+        Qt::KeyboardModifiers modifiers;
+        Action action;
+    };
+
+    // Add a rule given in QKeySequence's portable text format ("Ctrl+Shift+I");
+    // returns false if the text is not a single key combination
+    bool add(const QString& sequence, Action action);
+    void add(int key, Qt::KeyboardModifiers modifiers, Action action);
+
+    Action lookup(int key, Qt::KeyboardModifiers modifiers) const;
+
+    // Rules as added, before superset expansion
+    const QList<Entry>& entries() const { return m_entries; }
+
+    // Blocked shortcuts from the policy, plus Ctrl+Q to quit if a quit
+    // password is set
+    static ShortcutTable build(const QStringList& blockedShortcuts, bool withQuitShortcuts);
+
+    // Error for the first entry that add() would reject, or an empty string
+    static QString validate(const QStringList& blockedShortcuts);
+
+    static QString toString(int key, Qt::KeyboardModifiers modifiers);
+
+private:
+    static constexpr Qt::KeyboardModifiers RelevantModifiers =
+        Qt::ControlModifier | Qt::ShiftModifier | Qt::AltModifier | Qt::MetaModifier;
+
+    static int hashKey(int key, Qt::KeyboardModifiers modifiers) {
+        return key | int(modifiers & RelevantModifiers);
+    }
+
+    struct Slot {
+        Action action;
+        int specificity;           // Number of modifiers in the rule
+    };
+
+    QHash<int, Slot> m_slots;
+    QList<Entry> m_entries;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_SHORTCUT_TABLE_H
@@ -0,0 +1,178 @@
+#include "StartLoadController.h"
+#include "SebSchemeHandler.h"
+#include "../core/Logging.h"
+#include <QtWebEngineCore/QWebEngineLoadingInfo>
+#include <QtWebEngineCore/QWebEnginePage>
+#include <QtCore/QDateTime>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QDebug>
+
+namespace seb {
+namespace web {
+
+namespace {
+
+bool isOverloadStatus(int httpStatus) {
+    return httpStatus == 429 || httpStatus == 502 || httpStatus == 503 || httpStatus == 504;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+// Retry-After as delay-seconds or HTTP-date; -1 if absent or invalid
+int retryAfterMs(const QWebEngineLoadingInfo& info) {
+    const QMultiMap<QByteArray, QByteArray> headers = info.responseHeaders();
+    for (auto it = headers.cbegin(); it != headers.cend(); ++it) {
+        if (it.key().compare("retry-after", Qt::CaseInsensitive) != 0) {
+            continue;
+        }
+        const QByteArray value = it.value().trimmed();
+        bool ok = false;
+        int seconds = value.toInt(&ok);
+        if (ok && seconds >= 0) {
+            return int(qMin<qint64>(qint64(seconds) * 1000, 3600 * 1000));
+        }
+        QDateTime date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+        if (date.isValid()) {
+            return int(qBound<qint64>(0, QDateTime::currentDateTimeUtc().msecsTo(date), 3600 * 1000));
+        }
+    }
+    return -1;
+}
+#else
+int retryAfterMs(const QWebEngineLoadingInfo&) {
+    return -1;
+}
+#endif
+
+} // namespace
+
+StartLoadController::StartLoadController(QWebEnginePage* page,
+                                         const QUrl& startUrl,
+                                         const core::StartLoadSettings& settings,
+                                         QObject* parent)
+    : QObject(parent)
+    , m_page(page)
+    , m_startUrl(startUrl)
+    , m_settings(settings)
+    , m_attempt(0)
+    , m_loading(false)
+    , m_active(false)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &StartLoadController::load);
+}
+
+void StartLoadController::start() {
+    m_active = true;
+    connect(m_page, &QWebEnginePage::loadingChanged, this, &StartLoadController::handleLoadingChanged);
+
+    int delayMs = m_settings.spreadMs > 0 ? QRandomGenerator::global()->bounded(m_settings.spreadMs + 1) : 0;
+    if (delayMs == 0) {
+        load();
+        return;
+    }
+
+    qCDebug(core::lcStartLoad) << "Delaying start page load by" << delayMs << "ms";
+    showWaitingPage("Connecting to the exam server…", delayMs);
+    m_timer.start(delayMs);
+}
+
+void StartLoadController::load() {
+    m_loading = true;
+    m_page->setUrl(m_startUrl);
+}
+
+void StartLoadController::handleLoadingChanged(const QWebEngineLoadingInfo& info) {
+    // Ignore anything after the start phase and our own waiting page
+    if (!m_active || !m_loading) {
+        return;
+    }
+    const QUrl url = info.url();
+    const bool internal = url.scheme() == QLatin1String(SebSchemeHandler::SchemeName);
+    if (internal && !m_waitingPageUrl.isEmpty() && url.host() == m_waitingPageUrl.host()) {
+        return;
+    }
+
+    // The start URL (or a redirect) was blocked; retrying cannot help
+    if (internal && url.host() == QLatin1String("blocked")) {
+        if (info.status() != QWebEngineLoadingInfo::LoadStartedStatus) {
+            qCWarning(core::lcStartLoad) << "Start page load ended on the block page";
+            finish(false);
+        }
+        return;
+    }
+
+    if (info.status() == QWebEngineLoadingInfo::LoadStoppedStatus) {
+        qCWarning(core::lcStartLoad) << "Start page load was stopped";
+        finish(false);
+        return;
+    }
+
+    if (info.status() == QWebEngineLoadingInfo::LoadFailedStatus) {
+        if (info.errorDomain() == QWebEngineLoadingInfo::HttpStatusCodeDomain) {
+            scheduleRetry(retryAfterMs(info), QString("HTTP %1").arg(info.errorCode()));
+        } else {
+            scheduleRetry(-1, info.errorString());
+        }
+        return;
+    }
+
+    if (info.status() == QWebEngineLoadingInfo::LoadSucceededStatus) {
+        // Error responses with a body may still commit successfully
+        if (info.errorDomain() == QWebEngineLoadingInfo::HttpStatusCodeDomain && isOverloadStatus(info.errorCode())) {
+            scheduleRetry(retryAfterMs(info), QString("HTTP %1").arg(info.errorCode()));
+            return;
+        }
+        finish(true);
+    }
+}
+
+void StartLoadController::scheduleRetry(int retryAfterMs, const QString& reason) {
+    m_loading = false;
+
+    if (m_attempt >= m_settings.maxRetries) {
+        qCWarning(core::lcStartLoad) << "Start page failed to load after" << m_attempt << "retries:" << reason;
+        showWaitingPage("The exam server is not responding. Please ask the supervisor for help.", -1);
+        finish(false);
+        return;
+    }
+
+    // Retry-After wins, plus a little jitter so a room does not retry in lockstep
+    int delayMs = backoffDelayMs();
+    if (retryAfterMs >= 0) {
+        delayMs = retryAfterMs + QRandomGenerator::global()->bounded(m_settings.initialBackoffMs + 1);
+    }
+    ++m_attempt;
+
+    qCWarning(core::lcStartLoad) << "Start page load failed (" << reason << "), retry" << m_attempt << "of"
+               << m_settings.maxRetries << "in" << delayMs << "ms";
+    showWaitingPage("The exam server is busy. Retrying automatically…", delayMs);
+    m_timer.start(delayMs);
+}
+
+int StartLoadController::backoffDelayMs() const {
+    // Exponential backoff with "equal jitter": [delay / 2, delay]
+    qint64 delay = qint64(m_settings.initialBackoffMs) << qMin(m_attempt, 20);
+    delay = qMin<qint64>(delay, m_settings.maxBackoffMs);
+    qint64 half = delay / 2;
+    return int(half + QRandomGenerator::global()->bounded(half + 1));
+}
+
+void StartLoadController::finish(bool ok) {
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    m_loading = false;
+    disconnect(m_page, &QWebEnginePage::loadingChanged, this, &StartLoadController::handleLoadingChanged);
+    emit finished(ok);
+}
+
+void StartLoadController::showWaitingPage(const QString& message, int delayMs) {
+    // Countdown only when a retry is scheduled; otherwise this is final
+    m_waitingPageUrl = delayMs < 0 ? SebSchemeHandler::errorPageUrl(message, m_startUrl)
+                                   : SebSchemeHandler::waitingPageUrl(message, m_startUrl, delayMs);
+    m_page->setUrl(m_waitingPageUrl);
+}
+
+} // namespace web
+} // namespace seb
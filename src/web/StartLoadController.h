@@ -0,0 +1,62 @@
+#ifndef SEB_WEB_START_LOAD_CONTROLLER_H
+#define SEB_WEB_START_LOAD_CONTROLLER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QUrl>
+#include "../core/Config.h"
+
+class QWebEnginePage;
+class QWebEngineLoadingInfo;
+
+namespace seb {
+namespace web {
+
+// Admission control for the start page load.
+//
+// Spreads the initial load of a room of clients over a random delay,
+// and retries failed loads and overload responses (429/502/503/504) with
+// exponential backoff and jitter, honouring Retry-After when Qt exposes
+// response headers (Qt >= 6.6). A local waiting page is shown in place of
+// Chromium's error page. The controller goes idle after the first
+// successful load, or when the load is stopped or ends on the block page.
+class StartLoadController : public QObject {
+    Q_OBJECT
+
+public:
+    StartLoadController(QWebEnginePage* page,
+                        const QUrl& startUrl,
+                        const core::StartLoadSettings& settings,
+                        QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    // Emitted once: the start page loaded, all retries were used up, the
+    // load was stopped or the start URL was blocked
+    void finished(bool ok);
+
+private slots:
+    void load();
+    void handleLoadingChanged(const QWebEngineLoadingInfo& info);
+
+private:
+    void scheduleRetry(int retryAfterMs, const QString& reason);
+    void finish(bool ok);
+    void showWaitingPage(const QString& message, int delayMs);
+    int backoffDelayMs() const;
+
+    QWebEnginePage* m_page;
+    QUrl m_startUrl;
+    QUrl m_waitingPageUrl;         // Last waiting or error page shown
+    core::StartLoadSettings m_settings;
+    QTimer m_timer;
+    int m_attempt;
+    bool m_loading;
+    bool m_active;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_START_LOAD_CONTROLLER_H
@@ -0,0 +1,82 @@
+#include "UserScripts.h"
+#include "../core/Logging.h"
+#include <QtWebEngineCore/QWebEngineProfile>
+#include <QtWebEngineCore/QWebEngineScriptCollection>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+namespace seb {
+namespace web {
+
+namespace {
+
+QString readScript(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(core::lcWindow) << "Cannot read user script" << path << ":" << file.errorString();
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+QWebEngineScript makeScript(const QString& name, const QString& source,
+                            QWebEngineScript::ScriptWorldId world,
+                            QWebEngineScript::InjectionPoint injectionPoint) {
+    QWebEngineScript script;
+    script.setName(name);
+    script.setSourceCode(source);
+    script.setWorldId(world);
+    script.setInjectionPoint(injectionPoint);
+    script.setRunsOnSubFrames(true);
+    return script;
+}
+
+} // namespace
+
+QList<QWebEngineScript> UserScripts::build(const core::LockdownSettings& settings) {
+    const struct {
+        bool enabled;
+        const char* name;
+        const char* file;
+    } builtins[] = {
+        {settings.blockContextMenu, "seb-block-context-menu", ":/seb/scripts/block-context-menu.js"},
+        {settings.blockTextSelection, "seb-block-text-selection", ":/seb/scripts/block-text-selection.js"},
+        {settings.blockClipboard, "seb-block-clipboard", ":/seb/scripts/block-clipboard.js"},
+    };
+
+    QList<QWebEngineScript> scripts;
+    for (const auto& builtin : builtins) {
+        if (!builtin.enabled) {
+            continue;
+        }
+        const QString source = readScript(QLatin1String(builtin.file));
+        if (!source.isEmpty()) {
+            scripts.append(makeScript(QLatin1String(builtin.name), source,
+                                      QWebEngineScript::ApplicationWorld,
+                                      QWebEngineScript::DocumentCreation));
+        }
+    }
+
+    for (const core::UserScript& userScript : settings.userScripts) {
+        const QString source = readScript(userScript.path);
+        if (source.isEmpty()) {
+            continue;
+        }
+        scripts.append(makeScript(QFileInfo(userScript.path).fileName(), source,
+                                  userScript.mainWorld ? QWebEngineScript::MainWorld
+                                                       : QWebEngineScript::ApplicationWorld,
+                                  userScript.atDocumentReady ? QWebEngineScript::DocumentReady
+                                                             : QWebEngineScript::DocumentCreation));
+    }
+    return scripts;
+}
+
+void UserScripts::install(QWebEngineProfile* profile, const core::LockdownSettings& settings) {
+    const QList<QWebEngineScript> scripts = build(settings);
+    profile->scripts()->insert(scripts);
+    qCDebug(core::lcWindow) << "Installed" << scripts.size() << "user scripts";
+}
+
+} // namespace web
+} // namespace seb
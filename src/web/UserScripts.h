@@ -0,0 +1,31 @@
+#ifndef SEB_WEB_USER_SCRIPTS_H
+#define SEB_WEB_USER_SCRIPTS_H
+
+#include <QtWebEngineCore/QWebEngineScript>
+#include <QtCore/QList>
+#include "../core/Config.h"
+
+class QWebEngineProfile;
+
+namespace seb {
+namespace web {
+
+// Lockdown user scripts.
+//
+// The built-in lockdown scripts (compiled in as resources) and the policy's
+// script files are turned into QWebEngineScripts once and registered on the
+// profile. WebEngine then injects them into every document and subframe
+// itself, so nothing has to be sent to the renderer per navigation.
+// Built-in scripts run in an isolated world at document creation: they see
+// the DOM, but page scripts cannot see or remove them.
+class UserScripts {
+public:
+    static QList<QWebEngineScript> build(const core::LockdownSettings& settings);
+
+    static void install(QWebEngineProfile* profile, const core::LockdownSettings& settings);
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_USER_SCRIPTS_H
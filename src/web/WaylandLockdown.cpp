@@ -0,0 +1,198 @@
+#include "WaylandLockdown.h"
+#include "../core/Logging.h"
+#include <QtGui/QGuiApplication>
+#include <QtGui/QWindow>
+#include <QtCore/QDebug>
+#include <QtCore/QEvent>
+
+#ifdef SEB_HAVE_WAYLAND
+#include <QtGui/qpa/qplatformnativeinterface.h>
+#include <QtWaylandClient/QWaylandClientExtensionTemplate>
+#include "qwayland-idle-inhibit-unstable-v1.h"
+#include "qwayland-keyboard-shortcuts-inhibit-unstable-v1.h"
+#endif
+
+namespace seb {
+namespace web {
+
+#ifdef SEB_HAVE_WAYLAND
+namespace {
+
+class ShortcutsInhibitManager
+    : public QWaylandClientExtensionTemplate<ShortcutsInhibitManager>
+    , public QtWayland::zwp_keyboard_shortcuts_inhibit_manager_v1 {
+public:
+    ShortcutsInhibitManager()
+        : QWaylandClientExtensionTemplate<ShortcutsInhibitManager>(1)
+    {
+        initialize();
+    }
+
+    ~ShortcutsInhibitManager() override {
+        if (isInitialized()) {
+            destroy();
+        }
+    }
+};
+
+class ShortcutsInhibitor : public QtWayland::zwp_keyboard_shortcuts_inhibitor_v1 {
+public:
+    ShortcutsInhibitor(::zwp_keyboard_shortcuts_inhibitor_v1* object, WaylandLockdown* owner)
+        : QtWayland::zwp_keyboard_shortcuts_inhibitor_v1(object)
+        , m_owner(owner)
+    {
+    }
+
+    ~ShortcutsInhibitor() override {
+        destroy();
+    }
+
+    bool isActive() const { return m_active; }
+
+protected:
+    void zwp_keyboard_shortcuts_inhibitor_v1_active() override {
+        m_active = true;
+        qCDebug(core::lcWindow) << "Compositor shortcuts inhibited";
+        emit m_owner->shortcutsInhibitChanged(true);
+    }
+
+    void zwp_keyboard_shortcuts_inhibitor_v1_inactive() override {
+        // Denied by the user/compositor, or temporarily lifted (e.g. for
+        // the compositor's own emergency escape combination)
+        m_active = false;
+        qCWarning(core::lcWindow) << "Compositor shortcuts inhibition is not active";
+        emit m_owner->shortcutsInhibitChanged(false);
+    }
+
+private:
+    WaylandLockdown* m_owner;
+    bool m_active = false;
+};
+
+class IdleInhibitManager
+    : public QWaylandClientExtensionTemplate<IdleInhibitManager>
+    , public QtWayland::zwp_idle_inhibit_manager_v1 {
+public:
+    IdleInhibitManager()
+        : QWaylandClientExtensionTemplate<IdleInhibitManager>(1)
+    {
+        initialize();
+    }
+
+    ~IdleInhibitManager() override {
+        if (isInitialized()) {
+            destroy();
+        }
+    }
+};
+
+class IdleInhibitor : public QtWayland::zwp_idle_inhibitor_v1 {
+public:
+    explicit IdleInhibitor(::zwp_idle_inhibitor_v1* object)
+        : QtWayland::zwp_idle_inhibitor_v1(object)
+    {
+    }
+
+    ~IdleInhibitor() override {
+        destroy();
+    }
+};
+
+} // namespace
+
+struct WaylandLockdown::Private {
+    ShortcutsInhibitManager shortcutsManager;
+    IdleInhibitManager idleManager;
+    std::unique_ptr<ShortcutsInhibitor> shortcutsInhibitor;
+    std::unique_ptr<IdleInhibitor> idleInhibitor;
+};
+#else
+struct WaylandLockdown::Private {
+};
+#endif
+
+WaylandLockdown::WaylandLockdown(QWindow* window, QObject* parent)
+    : QObject(parent)
+    , m_window(window)
+{
+}
+
+WaylandLockdown::~WaylandLockdown() = default;
+
+bool WaylandLockdown::isSupported() {
+#ifdef SEB_HAVE_WAYLAND
+    return QGuiApplication::platformName().startsWith(QLatin1String("wayland"));
+#else
+    return false;
+#endif
+}
+
+void WaylandLockdown::start() {
+    if (!isSupported() || !m_window || d) {
+        return;
+    }
+    d = std::make_unique<Private>();
+
+#ifdef SEB_HAVE_WAYLAND
+    if (!d->shortcutsManager.isActive()) {
+        qCWarning(core::lcWindow) << "Compositor does not offer keyboard shortcuts inhibition;"
+                                  << "compositor shortcuts stay active";
+    }
+
+    // The globals may be announced after the window is up
+    connect(&d->shortcutsManager, &QWaylandClientExtension::activeChanged, this, &WaylandLockdown::attach);
+    connect(&d->idleManager, &QWaylandClientExtension::activeChanged, this, &WaylandLockdown::attach);
+#endif
+
+    // The wl_surface exists only once the window is exposed
+    m_window->installEventFilter(this);
+    attach();
+}
+
+bool WaylandLockdown::isShortcutsInhibitActive() const {
+#ifdef SEB_HAVE_WAYLAND
+    return d && d->shortcutsInhibitor && d->shortcutsInhibitor->isActive();
+#else
+    return false;
+#endif
+}
+
+bool WaylandLockdown::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == m_window && event->type() == QEvent::Expose) {
+        attach();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void WaylandLockdown::attach() {
+#ifdef SEB_HAVE_WAYLAND
+    if (!d || !m_window) {
+        return;
+    }
+
+    QPlatformNativeInterface* native = QGuiApplication::platformNativeInterface();
+    auto* surface = static_cast<::wl_surface*>(native->nativeResourceForWindow("surface", m_window));
+    auto* seat = static_cast<::wl_seat*>(native->nativeResourceForIntegration("wl_seat"));
+    if (!surface) {
+        return; // Retried on the next expose
+    }
+
+    if (!d->shortcutsInhibitor && seat && d->shortcutsManager.isActive()) {
+        d->shortcutsInhibitor = std::make_unique<ShortcutsInhibitor>(
+            d->shortcutsManager.inhibit_shortcuts(surface, seat), this);
+        qCDebug(core::lcWindow) << "Requested compositor shortcuts inhibition";
+    }
+
+    if (!d->idleInhibitor && d->idleManager.isActive()) {
+        d->idleInhibitor = std::make_unique<IdleInhibitor>(d->idleManager.create_inhibitor(surface));
+        qCDebug(core::lcIdle) << "Idle inhibited by the compositor while the window is visible";
+    }
+
+    if (d->shortcutsInhibitor && d->idleInhibitor) {
+        m_window->removeEventFilter(this);
+    }
+#endif
+}
+
+} // namespace web
+} // namespace seb
@@ -0,0 +1,55 @@
+#ifndef SEB_WEB_WAYLAND_LOCKDOWN_H
+#define SEB_WEB_WAYLAND_LOCKDOWN_H
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <memory>
+
+class QWindow;
+
+namespace seb {
+namespace web {
+
+// Compositor-side lockdown for a window on Wayland.
+//
+// Binds zwp_keyboard_shortcuts_inhibit_manager_v1 so that the compositor
+// forwards its own shortcuts (Super, Alt+Tab, workspace switching, ...) to
+// the window instead of acting on them, where KeyboardLockdown swallows the
+// blocked ones; and zwp_idle_inhibit_manager_v1 so the screen does not
+// blank or lock while the window is visible. Both are attached to the
+// window's wl_surface once it exists. Compositors may deny or not offer a
+// protocol; that is logged and the window keeps working.
+class WaylandLockdown : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WaylandLockdown(QWindow* window, QObject* parent = nullptr);
+    ~WaylandLockdown() override;
+
+    // Built with the protocols and running on a Wayland platform
+    static bool isSupported();
+
+    void start();
+
+    bool isShortcutsInhibitActive() const;
+
+signals:
+    // The compositor granted or withdrew the shortcuts inhibition
+    void shortcutsInhibitChanged(bool active);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void attach();
+
+    struct Private;
+
+    QPointer<QWindow> m_window;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace web
+} // namespace seb
+
+#endif // SEB_WEB_WAYLAND_LOCKDOWN_H
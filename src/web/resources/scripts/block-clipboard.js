@@ -0,0 +1,4 @@
+// Prevent copying exam content out of and pasting text into the page
+['copy', 'cut', 'paste'].forEach(function (type) {
+    window.addEventListener(type, function (e) { e.preventDefault(); }, true);
+});
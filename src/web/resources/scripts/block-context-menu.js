@@ -0,0 +1,2 @@
+// Suppress the page's context menu (capture phase on window, before page handlers)
+window.addEventListener('contextmenu', function (e) { e.preventDefault(); }, true);
@@ -0,0 +1,2 @@
+// Prevent starting a text selection
+window.addEventListener('selectstart', function (e) { e.preventDefault(); }, true);
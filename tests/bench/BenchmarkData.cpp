@@ -0,0 +1,130 @@
+#include "BenchmarkData.h"
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QXmlStreamWriter>
+#include <zlib.h>
+
+namespace seb {
+namespace bench {
+
+namespace {
+
+QByteArray gzip(const QByteArray& data) {
+    z_stream stream = {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+    QByteArray output(int(deflateBound(&stream, uLong(data.size()))), Qt::Uninitialized);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = uInt(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = uInt(output.size());
+    deflate(&stream, Z_FINISH);
+    output.resize(qsizetype(stream.total_out));
+    deflateEnd(&stream);
+    return output;
+}
+
+void writePlistValue(QXmlStreamWriter& xml, const QJsonValue& value) {
+    switch (value.type()) {
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        xml.writeStartElement("dict");
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            xml.writeTextElement("key", it.key());
+            writePlistValue(xml, it.value());
+        }
+        xml.writeEndElement();
+        break;
+    }
+    case QJsonValue::Array: {
+        xml.writeStartElement("array");
+        for (const QJsonValue& item : value.toArray()) {
+            writePlistValue(xml, item);
+        }
+        xml.writeEndElement();
+        break;
+    }
+    case QJsonValue::Bool:
+        xml.writeEmptyElement(value.toBool() ? "true" : "false");
+        break;
+    case QJsonValue::Double:
+        xml.writeTextElement("integer", QString::number(qint64(value.toDouble())));
+        break;
+    default:
+        xml.writeTextElement("string", value.toString());
+        break;
+    }
+}
+
+} // namespace
+
+QStringList makeAllowedDomains(int count) {
+    static const char* const suffixes[] = {"edu", "com", "net", "org", "io", "de", "ac.uk"};
+
+    QStringList domains;
+    domains.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        domains.append(QString("exam-host%1.provider%2.%3")
+                           .arg(i)
+                           .arg(i % 37)
+                           .arg(QLatin1String(suffixes[i % 7])));
+    }
+    return domains;
+}
+
+QStringList makeHostMix(const QStringList& allowedDomains) {
+    QStringList hosts;
+    for (int i = 0; i < 64; ++i) {
+        const QString& domain = allowedDomains.at((i * 7919) % allowedDomains.size());
+        switch (i % 8) {
+        case 0:
+        case 1:
+        case 2:
+            hosts.append("static.cdn." + domain);
+            break;
+        case 3:
+        case 4:
+            hosts.append(domain);
+            break;
+        default:
+            hosts.append(QString("tracker%1.analytics%2.net").arg(i).arg(i % 5));
+            break;
+        }
+    }
+    return hosts;
+}
+
+QJsonObject makePolicyJson(const QStringList& allowedDomains) {
+    QJsonObject root;
+    root["startUrl"] = "https://" + allowedDomains.first() + "/mod/quiz/view.php?id=42";
+    root["allowedDomains"] = QJsonArray::fromStringList(allowedDomains);
+    root["userAgentSuffix"] = "SEB-Linux/1.0";
+    root["clientVersion"] = "0.1.0";
+    root["clientType"] = "SEB-Linux";
+    root["sendConfigKey"] = true;
+    return root;
+}
+
+QByteArray makeSebFile(const QJsonObject& settings) {
+    QByteArray plist;
+    QXmlStreamWriter xml(&plist);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeDTD("<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" "
+                 "\"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">");
+    xml.writeStartElement("plist");
+    xml.writeAttribute("version", "1.0");
+    writePlistValue(xml, settings);
+    xml.writeEndElement();
+    xml.writeEndDocument();
+
+    return gzip("plnd" + gzip(plist));
+}
+
+bool writeFile(const QString& filePath, const QByteArray& data) {
+    QFile file(filePath);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(data) == data.size();
+}
+
+} // namespace bench
+} // namespace seb
@@ -0,0 +1,29 @@
+#ifndef SEB_BENCH_BENCHMARK_DATA_H
+#define SEB_BENCH_BENCHMARK_DATA_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+namespace seb {
+namespace bench {
+
+// Synthetic allowlist resembling an exam policy (LMS, CDNs, proctoring)
+QStringList makeAllowedDomains(int count);
+
+// 64 hosts: subdomains of allowed domains, exact matches and blocked
+// third-party hosts, interleaved like the requests of a real page
+QStringList makeHostMix(const QStringList& allowedDomains);
+
+// Policy in the seb-linux JSON schema
+QJsonObject makePolicyJson(const QStringList& allowedDomains);
+
+// Native .seb file (gzip("plnd" + gzip(plist))) for the given settings
+QByteArray makeSebFile(const QJsonObject& settings);
+
+bool writeFile(const QString& filePath, const QByteArray& data);
+
+} // namespace bench
+} // namespace seb
+
+#endif // SEB_BENCH_BENCHMARK_DATA_H
@@ -0,0 +1,160 @@
+#include "BenchmarkRunner.h"
+#include "Sha256.h"
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSysInfo>
+#include <QtCore/QThread>
+#include <cstdio>
+#include <ctime>
+
+namespace seb {
+namespace bench {
+
+namespace {
+
+qint64 cpuTimeNs() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+} // namespace
+
+void BenchmarkRunner::add(const QString& name, Function function) {
+    m_benchmarks.append(Benchmark{name, std::move(function)});
+}
+
+int BenchmarkRunner::run(const QStringList& arguments) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("seb-linux benchmark suite");
+    parser.addHelpOption();
+
+    QCommandLineOption filterOption("filter", "Only run benchmarks matching the regular expression", "regex");
+    QCommandLineOption minTimeOption("min-time", "Minimum run time per benchmark in seconds (default 0.5)", "seconds", "0.5");
+    QCommandLineOption jsonOption("json", "Write results as JSON to the given file", "file");
+    QCommandLineOption listOption("list", "List benchmarks and exit");
+    parser.addOption(filterOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(jsonOption);
+    parser.addOption(listOption);
+    parser.process(arguments);
+
+    QRegularExpression filter(parser.value(filterOption));
+    if (!filter.isValid()) {
+        std::fprintf(stderr, "Invalid --filter expression: %s\n", qPrintable(filter.errorString()));
+        return 1;
+    }
+
+    bool ok = false;
+    double minTime = parser.value(minTimeOption).toDouble(&ok);
+    if (!ok || minTime <= 0.0) {
+        std::fprintf(stderr, "Invalid --min-time value\n");
+        return 1;
+    }
+
+    QList<Result> results;
+    if (!parser.isSet(listOption)) {
+        std::printf("%-44s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+    }
+    for (const Benchmark& benchmark : std::as_const(m_benchmarks)) {
+        if (!filter.match(benchmark.name).hasMatch()) {
+            continue;
+        }
+        if (parser.isSet(listOption)) {
+            std::printf("%s\n", qPrintable(benchmark.name));
+            continue;
+        }
+
+        Result result = measure(benchmark, minTime);
+        std::printf("%-44s %14.1f %14.1f %12lld\n", qPrintable(result.name),
+                    result.realTimeNs, result.cpuTimeNs, static_cast<long long>(result.iterations));
+        std::fflush(stdout);
+        results.append(result);
+    }
+
+    if (parser.isSet(jsonOption) && !writeJson(parser.value(jsonOption), results)) {
+        std::fprintf(stderr, "Failed to write %s\n", qPrintable(parser.value(jsonOption)));
+        return 1;
+    }
+    return 0;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::measure(const Benchmark& benchmark, double minTimeSeconds) {
+    const qint64 minTimeNs = qint64(minTimeSeconds * 1e9);
+
+    // Warm up caches and lazily initialized state
+    benchmark.function();
+
+    qint64 iterations = 1;
+    for (;;) {
+        QElapsedTimer timer;
+        qint64 cpuStart = cpuTimeNs();
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+            benchmark.function();
+        }
+        qint64 elapsed = timer.nsecsElapsed();
+        qint64 cpuElapsed = cpuTimeNs() - cpuStart;
+
+        if (elapsed >= minTimeNs || iterations >= 1000000000) {
+            Result result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.realTimeNs = double(elapsed) / double(iterations);
+            result.cpuTimeNs = double(cpuElapsed) / double(iterations);
+            return result;
+        }
+
+        // Aim for the minimum time, growing at least 2x and at most 100x
+        double predicted = double(minTimeNs) * 1.2 * double(iterations) / double(qMax<qint64>(elapsed, 1));
+        iterations = qBound<qint64>(iterations * 2, qint64(predicted), iterations * 100);
+    }
+}
+
+bool BenchmarkRunner::writeJson(const QString& filePath, const QList<Result>& results) {
+    QJsonObject context;
+    context["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    context["host_name"] = QSysInfo::machineHostName();
+    context["executable"] = QCoreApplication::applicationFilePath();
+    context["num_cpus"] = QThread::idealThreadCount();
+    context["qt_version"] = QString::fromLatin1(qVersion());
+    context["sha256_hardware"] = core::Sha256::isHardwareAccelerated();
+#ifdef NDEBUG
+    context["library_build_type"] = "release";
+#else
+    context["library_build_type"] = "debug";
+#endif
+
+    QJsonArray benchmarks;
+    for (const Result& result : results) {
+        QJsonObject entry;
+        entry["name"] = result.name;
+        entry["run_name"] = result.name;
+        entry["run_type"] = "iteration";
+        entry["iterations"] = result.iterations;
+        entry["real_time"] = result.realTimeNs;
+        entry["cpu_time"] = result.cpuTimeNs;
+        entry["time_unit"] = "ns";
+        benchmarks.append(entry);
+    }
+
+    QJsonObject root;
+    root["context"] = context;
+    root["benchmarks"] = benchmarks;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(QJsonDocument(root).toJson()) != -1;
+}
+
+} // namespace bench
+} // namespace seb
@@ -0,0 +1,52 @@
+#ifndef SEB_BENCH_BENCHMARK_RUNNER_H
+#define SEB_BENCH_BENCHMARK_RUNNER_H
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <functional>
+
+namespace seb {
+namespace bench {
+
+// Keep the compiler from optimizing away a benchmarked result
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Minimal benchmark runner. Each benchmark function performs one iteration;
+// the runner calibrates the iteration count to the minimum run time and
+// reports real and CPU time per iteration. JSON output follows the Google
+// Benchmark schema so results can be diffed with its compare.py tooling.
+class BenchmarkRunner {
+public:
+    using Function = std::function<void()>;
+
+    void add(const QString& name, Function function);
+
+    // Parses --filter, --min-time, --json and --list; returns the exit code
+    int run(const QStringList& arguments);
+
+private:
+    struct Benchmark {
+        QString name;
+        Function function;
+    };
+
+    struct Result {
+        QString name;
+        qint64 iterations = 0;
+        double realTimeNs = 0.0;
+        double cpuTimeNs = 0.0;
+    };
+
+    static Result measure(const Benchmark& benchmark, double minTimeSeconds);
+    static bool writeJson(const QString& filePath, const QList<Result>& results);
+
+    QList<Benchmark> m_benchmarks;
+};
+
+} // namespace bench
+} // namespace seb
+
+#endif // SEB_BENCH_BENCHMARK_RUNNER_H
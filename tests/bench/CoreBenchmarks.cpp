@@ -0,0 +1,205 @@
+#include "BenchmarkData.h"
+#include "BenchmarkRunner.h"
+#include "ConfigKey.h"
+#include "ConfigLoader.h"
+#include "DomainMatcher.h"
+#include "HostVerdictCache.h"
+#include "Logging.h"
+#include "Metrics.h"
+#include "PolicyBlob.h"
+#include "PolicyStore.h"
+#include "Sha256.h"
+#include "UrlFilter.h"
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <memory>
+
+namespace seb {
+namespace bench {
+
+namespace {
+
+// The lookup removed in favour of DomainMatcher, kept as a baseline
+bool linearIsDomainAllowed(const QStringList& allowedDomains, const QString& host) {
+    if (allowedDomains.contains(host)) {
+        return true;
+    }
+    for (const QString& allowedDomain : allowedDomains) {
+        if (host == allowedDomain || host.endsWith("." + allowedDomain)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void registerConfigLoaderBenchmarks(BenchmarkRunner& runner, const QString& dataDir) {
+    const QStringList smallDomains = makeAllowedDomains(3);
+    const QStringList largeDomains = makeAllowedDomains(1000);
+
+    const QString smallJson = QDir(dataDir).filePath("policy_small.json");
+    const QString largeJson = QDir(dataDir).filePath("policy_large.json");
+    const QString largeSeb = QDir(dataDir).filePath("policy_large.seb");
+
+    writeFile(smallJson, QJsonDocument(makePolicyJson(smallDomains)).toJson());
+    writeFile(largeJson, QJsonDocument(makePolicyJson(largeDomains)).toJson());
+
+    // SEB naming plus a few MB of embedded resource data
+    QJsonObject sebSettings = makePolicyJson(largeDomains);
+    QJsonValue startUrl = sebSettings.take("startUrl");
+    sebSettings["startURL"] = startUrl;
+    sebSettings["embeddedResource"] = QString(4 * 1024 * 1024, QLatin1Char('A'));
+    writeFile(largeSeb, makeSebFile(sebSettings));
+
+    for (const QString& path : {smallJson, largeJson, largeSeb}) {
+        QString name = "ConfigLoader/" + QFileInfo(path).fileName();
+        runner.add(name, [path]() {
+            core::ConfigLoadResult result = core::ConfigLoader::loadFromFile(path);
+            doNotOptimize(result.success);
+        });
+    }
+
+    // Same large policy precompiled by seb-policyc: load plus first snapshot
+    const QString largeBlob = QDir(dataDir).filePath("policy_large.sebp");
+    writeFile(largeBlob, core::PolicyBlob::compile(core::ConfigLoader::loadFromFile(largeJson).policy));
+    for (const QString& path : {largeJson, largeBlob}) {
+        QString name = "PolicyStartup/" + QFileInfo(path).fileName();
+        runner.add(name, [path]() {
+            core::ConfigLoadResult result = core::ConfigLoader::loadFromFile(path);
+            core::PolicySnapshot snapshot(result.policy);
+            doNotOptimize(&snapshot);
+        });
+    }
+
+    auto largeSettings = std::make_shared<QJsonObject>(makePolicyJson(largeDomains));
+    runner.add("ConfigKey/compute_1000_domains", [largeSettings]() {
+        QString key = core::ConfigKey::compute(*largeSettings);
+        doNotOptimize(key.constData());
+    });
+}
+
+void registerDomainBenchmarks(BenchmarkRunner& runner) {
+    for (int count : {10, 100, 1000}) {
+        const QStringList domains = makeAllowedDomains(count);
+        auto hosts = std::make_shared<QStringList>(makeHostMix(domains));
+        auto matcher = std::make_shared<core::DomainMatcher>(domains);
+        auto list = std::make_shared<QStringList>(domains);
+
+        runner.add(QString("DomainMatcher/%1").arg(count), [matcher, hosts, i = 0]() mutable {
+            bool allowed = matcher->matches(hosts->at(i++ & 63));
+            doNotOptimize(allowed);
+        });
+
+        runner.add(QString("LinearScan/%1").arg(count), [list, hosts, i = 0]() mutable {
+            bool allowed = linearIsDomainAllowed(*list, hosts->at(i++ & 63));
+            doNotOptimize(allowed);
+        });
+    }
+
+    auto cache = std::make_shared<core::HostVerdictCache>(core::HostVerdictCache::capacityForDomainCount(100));
+    auto hosts = std::make_shared<QStringList>(makeHostMix(makeAllowedDomains(100)));
+    for (const QString& host : std::as_const(*hosts)) {
+        cache->store(host, true);
+    }
+    runner.add("HostVerdictCache/lookup", [cache, hosts, i = 0]() mutable {
+        core::HostVerdictCache::Verdict verdict = cache->lookup(hosts->at(i++ & 63));
+        doNotOptimize(verdict);
+    });
+
+    auto throttle = std::make_shared<core::LogThrottle>();
+    runner.add("LogThrottle/record", [throttle, hosts, i = 0]() mutable {
+        quint64 count = throttle->record(hosts->at(i++ & 63));
+        doNotOptimize(count);
+    });
+
+    // Pinning the current snapshot, as done once per request
+    core::Policy policy;
+    policy.allowedDomains = makeAllowedDomains(100);
+    auto store = std::make_shared<core::PolicyStore>(std::make_unique<const core::PolicySnapshot>(policy));
+    runner.add("PolicyStore/read", [store]() {
+        core::PolicyStore::Reader snapshot = store->read();
+        doNotOptimize(&*snapshot);
+    });
+}
+
+void registerUrlFilterBenchmarks(BenchmarkRunner& runner) {
+    for (int count : {10, 100}) {
+        // Mostly wildcard rules with a few regexes, the last one matching everything
+        QList<core::UrlFilterRule> rules;
+        const QStringList domains = makeAllowedDomains(count - 1);
+        for (int i = 0; i < domains.size(); ++i) {
+            core::UrlFilterRule rule;
+            rule.regex = i % 10 == 9;
+            rule.expression = rule.regex ? QString("^https://[a-z]+\\.%1/api/").arg(QRegularExpression::escape(domains[i]))
+                                         : domains[i] + "/exam";
+            rule.action = i % 2 ? core::UrlFilterRule::Action::Block : core::UrlFilterRule::Action::Allow;
+            rules.append(rule);
+        }
+        core::UrlFilterRule fallback;
+        fallback.expression = "*";
+        rules.append(fallback);
+
+        auto urls = std::make_shared<QList<QUrl>>();
+        for (const QString& host : makeHostMix(domains)) {
+            urls->append(QUrl("https://" + host + "/exam/page?id=1"));
+        }
+
+        auto filter = std::make_shared<core::UrlFilter>(rules);
+        runner.add(QString("UrlFilter/%1_rules").arg(count), [filter, urls, i = 0]() mutable {
+            core::UrlFilter::Verdict verdict = filter->evaluate(urls->at(i++ & 63));
+            doNotOptimize(verdict);
+        });
+
+        // Baseline: one compiled expression per rule, tried in order
+        auto perRule = std::make_shared<QList<QRegularExpression>>();
+        for (const core::UrlFilterRule& rule : std::as_const(rules)) {
+            QRegularExpression regex(core::UrlFilter::ruleToPattern(rule).prepend(QLatin1Char('^')),
+                                     QRegularExpression::CaseInsensitiveOption);
+            regex.optimize();
+            perRule->append(regex);
+        }
+        runner.add(QString("UrlFilterPerRule/%1_rules").arg(count), [perRule, urls, i = 0]() mutable {
+            const QString url = urls->at(i++ & 63).toString(QUrl::RemoveFragment);
+            qsizetype matched = -1;
+            for (qsizetype r = 0; r < perRule->size() && matched < 0; ++r) {
+                if (perRule->at(r).match(url).hasMatch()) {
+                    matched = r;
+                }
+            }
+            doNotOptimize(matched);
+        });
+    }
+}
+
+void registerHashBenchmarks(BenchmarkRunner& runner) {
+    for (int size : {64, 256, 4096}) {
+        auto data = std::make_shared<QByteArray>(size, 'x');
+        runner.add(QString("Sha256/%1").arg(size), [data]() {
+            QByteArray digest = core::Sha256::hash(*data);
+            doNotOptimize(digest.constData());
+        });
+    }
+}
+
+void registerMetricsBenchmarks(BenchmarkRunner& runner) {
+    auto histogram = std::make_shared<core::LatencyHistogram>();
+    auto value = std::make_shared<qint64>(0);
+    runner.add("LatencyHistogram/record", [histogram, value]() {
+        // Walk through a spread of latencies so all bucket ranges are hit
+        *value = (*value * 31 + 7919) & 0xFFFFF;
+        histogram->record(*value);
+    });
+}
+
+} // namespace
+
+void registerCoreBenchmarks(BenchmarkRunner& runner, const QString& dataDir) {
+    registerConfigLoaderBenchmarks(runner, dataDir);
+    registerDomainBenchmarks(runner);
+    registerUrlFilterBenchmarks(runner);
+    registerHashBenchmarks(runner);
+    registerMetricsBenchmarks(runner);
+}
+
+} // namespace bench
+} // namespace seb
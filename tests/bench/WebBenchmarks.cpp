@@ -0,0 +1,171 @@
+#include "BenchmarkData.h"
+#include "BenchmarkRunner.h"
+#include "Config.h"
+#include "DomainMatcher.h"
+#include "PolicyStore.h"
+#include "RequestHasher.h"
+#include "RequestHeaders.h"
+#include "RequestInterceptor.h"
+#include "ResourceType.h"
+#include "SebSchemeHandler.h"
+#include <QtCore/QUrl>
+#include <memory>
+
+namespace seb {
+namespace bench {
+
+namespace {
+
+// Stand-in for QWebEngineUrlRequestInfo, which cannot be constructed
+// outside of Qt WebEngine. Header storage mimics its per-request map.
+class FakeRequestInfo final : public web::InterceptedRequest {
+public:
+    explicit FakeRequestInfo(const QUrl& url, int resourceType = 0, const QUrl& firstPartyUrl = QUrl())
+        : m_url(url), m_firstPartyUrl(firstPartyUrl), m_resourceType(resourceType) {}
+
+    QUrl requestUrl() const override { return m_url; }
+    QUrl firstPartyUrl() const override { return m_firstPartyUrl; }
+    int resourceType() const override { return m_resourceType; }
+    void block(bool shouldBlock) override { m_blocked = shouldBlock; }
+    void setHttpHeader(const QByteArray& name, const QByteArray& value) override {
+        m_headers.append({name, value});
+    }
+
+    bool isBlocked() const { return m_blocked; }
+    void reset() {
+        m_blocked = false;
+        m_headers.clear();
+    }
+
+private:
+    QUrl m_url;
+    QUrl m_firstPartyUrl;
+    int m_resourceType;
+    bool m_blocked = false;
+    QList<QPair<QByteArray, QByteArray>> m_headers;
+};
+
+std::shared_ptr<web::RequestInterceptor> makeInterceptor(const core::Policy& policy) {
+    auto store = QSharedPointer<core::PolicyStore>::create(std::make_unique<const core::PolicySnapshot>(policy));
+    return std::make_shared<web::RequestInterceptor>(policy, store);
+}
+
+// One request per iteration, cycling over the given URLs; main frame
+// requests unless a resource type and page URL are given
+BenchmarkRunner::Function interceptLoop(std::shared_ptr<web::RequestInterceptor> interceptor,
+                                        const QList<QUrl>& urls, int resourceType = 0,
+                                        const QUrl& firstPartyUrl = QUrl()) {
+    auto requests = std::make_shared<QList<FakeRequestInfo>>();
+    for (const QUrl& url : urls) {
+        requests->append(FakeRequestInfo(url, resourceType, firstPartyUrl));
+    }
+    return [interceptor, requests, i = 0]() mutable {
+        FakeRequestInfo& request = (*requests)[i++ % requests->size()];
+        request.reset();
+        interceptor->handleRequest(request);
+        doNotOptimize(request.isBlocked());
+    };
+}
+
+// Header encoding and injection without the rest of the interceptor: the
+// encoded list shared across requests against encoding it per request
+void registerHeaderBenchmarks(BenchmarkRunner& runner, const core::Policy& policy, const QUrl& url) {
+    auto request = std::make_shared<FakeRequestInfo>(url);
+    auto headers = std::make_shared<core::HeaderList>(core::RequestHeaders::encode(policy));
+    auto sharedPolicy = std::make_shared<core::Policy>(policy);
+
+    runner.add("Headers/encode", [sharedPolicy]() {
+        core::HeaderList encoded = core::RequestHeaders::encode(*sharedPolicy);
+        doNotOptimize(encoded.constData());
+    });
+    runner.add("Headers/inject_shared", [request, headers]() {
+        request->reset();
+        for (const auto& header : *headers) {
+            request->setHttpHeader(header.first, header.second);
+        }
+        doNotOptimize(request.get());
+    });
+    runner.add("Headers/inject_encode_per_request", [request, sharedPolicy]() {
+        request->reset();
+        for (const auto& header : core::RequestHeaders::encode(*sharedPolicy)) {
+            request->setHttpHeader(header.first, header.second);
+        }
+        doNotOptimize(request.get());
+    });
+
+    // Verification hashes: memoized URL against a fresh SHA-256 per request
+    auto hasher = std::make_shared<core::RequestHasher>(policy.browserExamKey, policy.configKey);
+    auto encodedUrl = std::make_shared<QByteArray>(url.toEncoded(QUrl::RemoveFragment));
+    auto key = std::make_shared<QByteArray>(policy.browserExamKey.toUtf8());
+    runner.add("Headers/hashes_memoized", [hasher, encodedUrl]() {
+        core::RequestHasher::Hashes hashes = hasher->hashesFor(*encodedUrl);
+        doNotOptimize(hashes.requestHash.constData());
+    });
+    runner.add("Headers/hashes_uncached", [encodedUrl, key]() {
+        QByteArray hash = core::RequestHasher::computeHash(*encodedUrl, *key);
+        doNotOptimize(hash.constData());
+    });
+}
+
+} // namespace
+
+void registerWebBenchmarks(BenchmarkRunner& runner) {
+    const QStringList domains = makeAllowedDomains(100);
+    const QStringList hosts = makeHostMix(domains);
+
+    core::Policy policy;
+    policy.startUrl = "https://" + domains.first() + "/";
+    policy.allowedDomains = domains;
+    policy.configKey = QString(64, QLatin1Char('c'));
+    policy.browserExamKey = QString(64, QLatin1Char('b'));
+
+    core::DomainMatcher matcher(domains);
+    QList<QUrl> allowedUrls;
+    QList<QUrl> blockedUrls;
+    for (int i = 0; i < 256; ++i) {
+        const QString& host = hosts.at(i % hosts.size());
+        QUrl url(QString("https://%1/theme/styles.php/boost/%2/all#top").arg(host).arg(i));
+        (matcher.matches(host) ? allowedUrls : blockedUrls).append(url);
+    }
+
+    runner.add("Interceptor/allowed", interceptLoop(makeInterceptor(policy), allowedUrls));
+    runner.add("Interceptor/blocked", interceptLoop(makeInterceptor(policy), blockedUrls));
+
+    // Header injection alone: no verification hashes
+    core::Policy headersOnly = policy;
+    headersOnly.configKey.clear();
+    headersOnly.browserExamKey.clear();
+    runner.add("Interceptor/headers_only", interceptLoop(makeInterceptor(headersOnly), allowedUrls));
+    registerHeaderBenchmarks(runner, policy, allowedUrls.first());
+
+    // XHR subresources against a typical bandwidth rule set: only the
+    // exam API may be called, media, fonts, prefetch and pings are dropped
+    core::Policy withResourceRules = policy;
+    auto resourceRule = [](const QStringList& types, const QStringList& domains, core::ResourceRule::Action action) {
+        core::ResourceRule rule;
+        rule.types = types;
+        rule.domains = domains;
+        rule.action = action;
+        return rule;
+    };
+    withResourceRules.resourceRules = {
+        resourceRule({"media", "prefetch", "ping"}, {}, core::ResourceRule::Action::Block),
+        resourceRule({"font"}, {}, core::ResourceRule::Action::Block),
+        resourceRule({"xhr"}, {domains.first()}, core::ResourceRule::Action::Allow),
+        resourceRule({"xhr"}, {}, core::ResourceRule::Action::Block),
+    };
+    withResourceRules.resourceRules[1].thirdPartyOnly = true;
+    const int xhr = core::ResourceType::slotFromName(u"xhr");
+    runner.add("Interceptor/resource_rules",
+               interceptLoop(makeInterceptor(withResourceRules), allowedUrls, xhr, QUrl(policy.startUrl)));
+
+    const QString blockedUrl = blockedUrls.first().toString();
+    const QString startUrl = policy.startUrl;
+    runner.add("BlockPage/url", [blockedUrl, startUrl]() {
+        QUrl url = web::SebSchemeHandler::blockPageUrl(blockedUrl, startUrl);
+        doNotOptimize(url);
+    });
+}
+
+} // namespace bench
+} // namespace seb
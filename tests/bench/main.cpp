@@ -0,0 +1,45 @@
+#include "BenchmarkRunner.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+#include <cstdio>
+
+namespace seb {
+namespace bench {
+void registerCoreBenchmarks(BenchmarkRunner& runner, const QString& dataDir);
+void registerWebBenchmarks(BenchmarkRunner& runner);
+} // namespace bench
+} // namespace seb
+
+namespace {
+
+// Blocked requests log a warning each; keep the output readable
+void quietMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message) {
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        std::fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("seb-bench");
+
+    // Keep anything written through standard paths away from the real user dirs
+    QStandardPaths::setTestModeEnabled(true);
+    qInstallMessageHandler(quietMessageHandler);
+
+    QTemporaryDir dataDir;
+    if (!dataDir.isValid()) {
+        std::fprintf(stderr, "Failed to create temporary directory\n");
+        return 1;
+    }
+
+    seb::bench::BenchmarkRunner runner;
+    seb::bench::registerCoreBenchmarks(runner, dataDir.path());
+    seb::bench::registerWebBenchmarks(runner);
+
+    return runner.run(app.arguments());
+}
@@ -0,0 +1,190 @@
+#include "CachingProxy.h"
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+#include <QtNetwork/QSslCertificate>
+#include <QtNetwork/QSslKey>
+#include <QtNetwork/QSslSocket>
+#include <QtNetwork/QTcpServer>
+
+namespace seb {
+namespace e2e {
+
+namespace {
+
+constexpr int UpstreamTimeoutMs = 5000;
+
+// Hands out QSslSocket connections, so tunnels can switch to TLS after CONNECT
+class TlsCapableServer : public QTcpServer {
+public:
+    using QTcpServer::QTcpServer;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override {
+        QSslSocket* socket = new QSslSocket(this);
+        if (socket->setSocketDescriptor(socketDescriptor)) {
+            addPendingConnection(socket);
+        } else {
+            delete socket;
+        }
+    }
+};
+
+QByteArray errorResponse(int status, const char* reason) {
+    return "HTTP/1.1 " + QByteArray::number(status) + ' ' + reason
+         + "\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n";
+}
+
+qint64 contentLength(const QByteArray& headers) {
+    for (const QByteArray& line : headers.split('\n')) {
+        if (line.toLower().startsWith("content-length:")) {
+            return line.mid(15).trimmed().toLongLong();
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+CachingProxy::CachingProxy(QObject* parent)
+    : QObject(parent)
+    , m_port(0)
+    , m_server(nullptr)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+bool CachingProxy::listen(qintptr socketDescriptor, QString* errorString) {
+    QFile certFile(QStringLiteral(":/e2e/lms.test.crt"));
+    QFile keyFile(QStringLiteral(":/e2e/lms.test.key"));
+    if (!certFile.open(QIODevice::ReadOnly) || !keyFile.open(QIODevice::ReadOnly)) {
+        *errorString = QStringLiteral("Bundled test certificate is missing");
+        return false;
+    }
+
+    m_ssl = QSslConfiguration::defaultConfiguration();
+    m_ssl.setLocalCertificate(QSslCertificate(certFile.readAll(), QSsl::Pem));
+    m_ssl.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem));
+    m_ssl.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    m_server = new TlsCapableServer(this);
+    connect(m_server, &QTcpServer::pendingConnectionAvailable, this, &CachingProxy::handleConnection);
+    if (!m_server->setSocketDescriptor(socketDescriptor)) {
+        *errorString = m_server->errorString();
+        return false;
+    }
+    m_port = m_server->serverPort();
+    return true;
+}
+
+QList<QByteArray> CachingProxy::tunnelledHosts() const {
+    QMutexLocker locker(&m_hostsMutex);
+    return m_tunnelledHosts.values();
+}
+
+void CachingProxy::handleConnection() {
+    while (QTcpSocket* pending = m_server->nextPendingConnection()) {
+        QSslSocket* socket = static_cast<QSslSocket*>(pending);
+        connect(socket, &QSslSocket::readyRead, this, [this, socket]() { handleReadyRead(socket); });
+        connect(socket, &QSslSocket::disconnected, this, [this, socket]() {
+            m_clients.remove(socket);
+            socket->deleteLater();
+        });
+        if (socket->bytesAvailable() > 0) {
+            handleReadyRead(socket);
+        }
+    }
+}
+
+void CachingProxy::handleReadyRead(QSslSocket* socket) {
+    Client& client = m_clients[socket];
+    client.buffer += socket->readAll();
+
+    // CONNECT first, then GET requests (no body) inside the tunnel
+    qsizetype end;
+    while ((end = client.buffer.indexOf("\r\n\r\n")) >= 0) {
+        const QByteArray request = client.buffer.left(end);
+        client.buffer.remove(0, end + 4);
+
+        const QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+        if (requestLine.size() != 3) {
+            socket->disconnectFromHost();
+            return;
+        }
+
+        if (client.authority.isEmpty()) {
+            const QByteArray authority = requestLine[1];
+            if (requestLine[0] != "CONNECT" || authority.lastIndexOf(':') <= 0) {
+                socket->write(errorResponse(501, "Not Implemented"));
+                socket->disconnectFromHost();
+                return;
+            }
+            client.authority = authority;
+            {
+                QMutexLocker locker(&m_hostsMutex);
+                m_tunnelledHosts.insert(authority.left(authority.lastIndexOf(':')));
+            }
+            // The client sends its TLS handshake only after this reply
+            socket->write("HTTP/1.1 200 Connection established\r\n\r\n");
+            socket->setSslConfiguration(m_ssl);
+            socket->startServerEncryption();
+            return;
+        }
+
+        if (requestLine[0] != "GET") {
+            socket->write(errorResponse(405, "Method Not Allowed"));
+            socket->disconnectFromHost();
+            return;
+        }
+        socket->write(respond(client.authority, requestLine[1]));
+    }
+}
+
+QByteArray CachingProxy::respond(const QByteArray& authority, const QByteArray& path) {
+    const QByteArray url = "https://" + authority + path;
+    const auto cached = m_cache.constFind(url);
+    if (cached != m_cache.constEnd()) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return *cached;
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    const QByteArray response = fetch(authority, path);
+    if (response.isEmpty()) {
+        return errorResponse(502, "Bad Gateway");
+    }
+    m_cache.insert(url, response);
+    return response;
+}
+
+QByteArray CachingProxy::fetch(const QByteArray& authority, const QByteArray& path) const {
+    const qsizetype colon = authority.lastIndexOf(':');
+    const QString host = QString::fromLatin1(authority.left(colon));
+    const quint16 port = authority.mid(colon + 1).toUShort();
+
+    QSslSocket upstream;
+    upstream.setPeerVerifyMode(QSslSocket::VerifyNone);
+    upstream.connectToHostEncrypted(QStringLiteral("127.0.0.1"), port, host);
+    if (!upstream.waitForEncrypted(UpstreamTimeoutMs)) {
+        return QByteArray();
+    }
+    upstream.write("GET " + path + " HTTP/1.1\r\nHost: " + authority + "\r\nConnection: close\r\n\r\n");
+
+    // Read exactly one response; the origin may keep the connection open
+    QByteArray response;
+    qsizetype headerEnd = -1;
+    qint64 length = -1;
+    while (upstream.waitForReadyRead(UpstreamTimeoutMs)) {
+        response += upstream.readAll();
+        if (headerEnd < 0 && (headerEnd = response.indexOf("\r\n\r\n")) >= 0) {
+            length = contentLength(response.left(headerEnd));
+        }
+        if (headerEnd >= 0 && length >= 0 && response.size() >= headerEnd + 4 + length) {
+            return response.left(headerEnd + 4 + length);
+        }
+    }
+    return QByteArray();
+}
+
+} // namespace e2e
+} // namespace seb
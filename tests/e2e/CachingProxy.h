@@ -0,0 +1,70 @@
+#ifndef SEB_E2E_CACHING_PROXY_H
+#define SEB_E2E_CACHING_PROXY_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtNetwork/QSslConfiguration>
+#include <atomic>
+
+class QSslSocket;
+class QTcpServer;
+
+namespace seb {
+namespace e2e {
+
+// Local stand-in for a classroom caching proxy (Squid with SSL bump).
+//
+// Accepts CONNECT tunnels, terminates TLS with the bundled lms.test
+// certificate and answers GET requests from an in-memory cache keyed by
+// URL. Misses are fetched from the origin over a new TLS connection, with
+// every *.test host resolved to 127.0.0.1 like in the browser. Responses
+// are cached regardless of their Cache-Control, as exam-room proxies are
+// usually configured to, and errors too (like Squid's negative caching).
+// Upstream fetches block the proxy's thread, so run it on its own.
+class CachingProxy : public QObject {
+    Q_OBJECT
+
+public:
+    explicit CachingProxy(QObject* parent = nullptr);
+
+    // Take over a socket already listening on 127.0.0.1; call from the
+    // proxy's thread
+    bool listen(qintptr socketDescriptor, QString* errorString);
+    quint16 port() const { return m_port; }
+
+    // Thread-safe counters
+    quint64 hits() const { return m_hits.load(std::memory_order_relaxed); }
+    quint64 misses() const { return m_misses.load(std::memory_order_relaxed); }
+    QList<QByteArray> tunnelledHosts() const;
+
+private:
+    struct Client {
+        QByteArray buffer;
+        QByteArray authority;      // host:port of the CONNECT, empty until tunnelled
+    };
+
+    void handleConnection();
+    void handleReadyRead(QSslSocket* socket);
+    QByteArray respond(const QByteArray& authority, const QByteArray& path);
+    QByteArray fetch(const QByteArray& authority, const QByteArray& path) const;
+
+    quint16 m_port;
+    QTcpServer* m_server;
+    QSslConfiguration m_ssl;
+    QHash<QSslSocket*, Client> m_clients;
+    QHash<QByteArray, QByteArray> m_cache;
+    mutable QMutex m_hostsMutex;
+    QSet<QByteArray> m_tunnelledHosts;
+    std::atomic<quint64> m_hits;
+    std::atomic<quint64> m_misses;
+};
+
+} // namespace e2e
+} // namespace seb
+
+#endif // SEB_E2E_CACHING_PROXY_H
@@ -0,0 +1,161 @@
+#include "LmsServer.h"
+#include <QtCore/QFile>
+#include <QtNetwork/QSslCertificate>
+#include <QtNetwork/QSslConfiguration>
+#include <QtNetwork/QSslKey>
+#include <QtNetwork/QSslServer>
+#include <QtNetwork/QSslSocket>
+
+namespace seb {
+namespace e2e {
+
+namespace {
+
+// 1x1 transparent PNG
+const unsigned char Pixel[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0x15, 0xc4,
+    0x89, 0x00, 0x00, 0x00, 0x0b, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x00, 0x02, 0x00,
+    0x00, 0x05, 0x00, 0x01, 0xe9, 0xfa, 0xdc, 0xd8, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+    0xae, 0x42, 0x60, 0x82
+};
+
+const char* const BlockedHosts[] = {"tracker.blocked.test", "ads.blocked.test"};
+
+QByteArray response(int status, const char* reason, const char* contentType, const QByteArray& body) {
+    QByteArray result = "HTTP/1.1 " + QByteArray::number(status) + ' ' + reason + "\r\n";
+    result += "Content-Type: ";
+    result += contentType;
+    result += "\r\nContent-Length: " + QByteArray::number(body.size());
+    result += "\r\nCache-Control: no-store\r\nConnection: keep-alive\r\n\r\n";
+    return result + body;
+}
+
+} // namespace
+
+LmsServer::LmsServer(int subresources, int blockedEvery, QObject* parent)
+    : QObject(parent)
+    , m_subresources(subresources)
+    , m_blockedEvery(blockedEvery)
+    , m_port(0)
+    , m_server(nullptr)
+    , m_served(0)
+{
+}
+
+bool LmsServer::listen(qintptr socketDescriptor, QString* errorString) {
+    QFile certFile(QStringLiteral(":/e2e/lms.test.crt"));
+    QFile keyFile(QStringLiteral(":/e2e/lms.test.key"));
+    if (!certFile.open(QIODevice::ReadOnly) || !keyFile.open(QIODevice::ReadOnly)) {
+        *errorString = QStringLiteral("Bundled test certificate is missing");
+        return false;
+    }
+
+    QSslConfiguration ssl = QSslConfiguration::defaultConfiguration();
+    ssl.setLocalCertificate(QSslCertificate(certFile.readAll(), QSsl::Pem));
+    ssl.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem));
+    ssl.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    m_server = new QSslServer(this);
+    m_server->setSslConfiguration(ssl);
+    connect(m_server, &QTcpServer::pendingConnectionAvailable, this, &LmsServer::handleConnection);
+    if (!m_server->setSocketDescriptor(socketDescriptor)) {
+        *errorString = m_server->errorString();
+        return false;
+    }
+    m_port = m_server->serverPort();
+    return true;
+}
+
+bool LmsServer::isBlocked(int index) const {
+    return m_blockedEvery > 0 && index % m_blockedEvery == m_blockedEvery - 1;
+}
+
+int LmsServer::expectedBlocked() const {
+    int count = 0;
+    for (int i = 0; i < m_subresources; ++i) {
+        count += isBlocked(i) ? 1 : 0;
+    }
+    return count;
+}
+
+QByteArray LmsServer::coursePage() const {
+    // Roughly what an LMS quiz page pulls in: theme CSS, many small
+    // scripts, icons, plus analytics on third-party hosts
+    QByteArray head;
+    QByteArray body;
+    for (int i = 0; i < m_subresources; ++i) {
+        const QByteArray host = isBlocked(i) ? QByteArray(BlockedHosts[i % 2])
+                              : i % 2 ? QByteArray(QByteArray("cdn.") + Host)
+                              : QByteArray(Host);
+        const QByteArray origin = "https://" + host + ':' + QByteArray::number(m_port);
+        const QByteArray index = QByteArray::number(i);
+        switch (i % 3) {
+        case 0:
+            body += "<img src=\"" + origin + "/static/img/" + index + ".png\" width=\"1\" height=\"1\" alt=\"\">\n";
+            break;
+        case 1:
+            head += "<script defer src=\"" + origin + "/static/js/" + index + ".js\"></script>\n";
+            break;
+        default:
+            head += "<link rel=\"stylesheet\" href=\"" + origin + "/static/css/" + index + ".css\">\n";
+            break;
+        }
+    }
+
+    return "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>Course</title>\n" + head
+         + "</head><body><h1>Quiz</h1>\n" + body + "</body></html>\n";
+}
+
+void LmsServer::handleConnection() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { handleReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+        if (socket->bytesAvailable() > 0) {
+            handleReadyRead(socket);
+        }
+    }
+}
+
+void LmsServer::handleReadyRead(QTcpSocket* socket) {
+    QByteArray& buffer = m_buffers[socket];
+    buffer += socket->readAll();
+
+    // Requests carry no body (GET only); pipelined ones are answered in order
+    qsizetype end;
+    while ((end = buffer.indexOf("\r\n\r\n")) >= 0) {
+        const QByteArray request = buffer.left(end);
+        buffer.remove(0, end + 4);
+
+        const QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+        if (requestLine.size() != 3 || requestLine[0] != "GET") {
+            socket->write(response(405, "Method Not Allowed", "text/plain", "GET only\n"));
+            socket->disconnectFromHost();
+            return;
+        }
+        socket->write(respond(requestLine[1]));
+        m_served.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+QByteArray LmsServer::respond(const QByteArray& path) const {
+    if (path == CoursePath) {
+        return response(200, "OK", "text/html; charset=utf-8", coursePage());
+    }
+    if (path.startsWith("/static/img/")) {
+        return response(200, "OK", "image/png", QByteArray(reinterpret_cast<const char*>(Pixel), sizeof(Pixel)));
+    }
+    if (path.startsWith("/static/js/")) {
+        return response(200, "OK", "text/javascript", "window.loadedScripts = (window.loadedScripts || 0) + 1;\n");
+    }
+    if (path.startsWith("/static/css/")) {
+        return response(200, "OK", "text/css", "h1 { margin: 0; }\n");
+    }
+    return response(404, "Not Found", "text/plain", "Not found\n");
+}
+
+} // namespace e2e
+} // namespace seb
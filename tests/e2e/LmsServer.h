@@ -0,0 +1,64 @@
+#ifndef SEB_E2E_LMS_SERVER_H
+#define SEB_E2E_LMS_SERVER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <atomic>
+
+class QSslServer;
+class QTcpSocket;
+
+namespace seb {
+namespace e2e {
+
+// Local HTTPS stand-in for an exam server.
+//
+// Serves a synthetic course page that pulls in `subresources` images,
+// scripts and stylesheets from lms.test and cdn.lms.test; every
+// `blockedEvery`-th one points at a host outside the allowlist
+// (*.blocked.test) instead. HTTP/1.1 with keep-alive, GET only, responses
+// are marked no-store so every run measures a cold load. Uses the bundled
+// self-signed certificate for lms.test and *.lms.test.
+class LmsServer : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr char Host[] = "lms.test";
+    static constexpr char CoursePath[] = "/course";
+
+    LmsServer(int subresources, int blockedEvery, QObject* parent = nullptr);
+
+    // Take over a socket already listening on 127.0.0.1, so the port can be
+    // known before QApplication exists; call from the server's thread
+    bool listen(qintptr socketDescriptor, QString* errorString);
+    quint16 port() const { return m_port; }
+
+    // Subresources of the course page on blocked hosts
+    int expectedBlocked() const;
+
+    // Requests answered so far; thread-safe
+    quint64 servedRequests() const { return m_served.load(std::memory_order_relaxed); }
+
+    QByteArray coursePage() const;
+
+private:
+    void handleConnection();
+    void handleReadyRead(QTcpSocket* socket);
+    QByteArray respond(const QByteArray& path) const;
+
+    bool isBlocked(int index) const;
+
+    int m_subresources;
+    int m_blockedEvery;
+    quint16 m_port;
+    QSslServer* m_server;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    std::atomic<quint64> m_served;
+};
+
+} // namespace e2e
+} // namespace seb
+
+#endif // SEB_E2E_LMS_SERVER_H
@@ -0,0 +1,370 @@
+#include "CachingProxy.h"
+#include "ConfigLoader.h"
+#include "LmsServer.h"
+#include "MainWindow.h"
+#include "Metrics.h"
+#include "ProxyConfig.h"
+#include "ResourceProfile.h"
+#include "SebSchemeHandler.h"
+#include <QtWidgets/QApplication>
+#include <QtWebEngineWidgets/QWebEngineView>
+#include <QtCore/QCommandLineOption>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Blocked requests log a warning each; keep the output readable
+void quietMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message) {
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        std::fprintf(stderr, "%s\n", qPrintable(message));
+    }
+}
+
+// Socket listening on 127.0.0.1 with an ephemeral port; -1 on failure
+int listeningSocket(quint16* port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(fd, SOMAXCONN) != 0
+        || ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    *port = ntohs(address.sin_port);
+    return fd;
+}
+
+// High-water mark of this (browser) process from /proc/self/status
+qint64 peakRssKb() {
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    for (const QByteArray& line : status.readAll().split('\n')) {
+        if (line.startsWith("VmHWM:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+// Loads a synthetic LMS page through the real MainWindow on the offscreen
+// platform and reports load time, interceptor cost, blocking and memory
+int main(int argc, char* argv[])
+{
+    const QStringList arguments = [argc, argv]() {
+        QStringList list;
+        for (int i = 0; i < argc; ++i) {
+            list << QString::fromLocal8Bit(argv[i]);
+        }
+        return list;
+    }();
+
+    // Everything Chromium reads has to be in place before QApplication
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    if (arguments.contains(QStringLiteral("--low-memory"))) {
+        seb::core::ResourceProfile::apply(seb::core::ResourceSettings::lowMemory());
+    }
+    const bool useProxy = arguments.contains(QStringLiteral("--proxy"));
+
+    // The policy names the server and proxy ports and, as in seb-linux, is
+    // loaded and applied before QApplication; the sockets are opened now and
+    // handed to the servers once their threads can run
+    quint16 serverPort = 0;
+    quint16 proxyPort = 0;
+    const int serverSocket = listeningSocket(&serverPort);
+    const int proxySocket = useProxy ? listeningSocket(&proxyPort) : -1;
+    if (serverSocket < 0 || (useProxy && proxySocket < 0)) {
+        std::perror("Failed to open a listening socket");
+        return 1;
+    }
+
+    // Go through the regular configuration path
+    QTemporaryDir dataDir;
+    const QString startUrl = QString("https://%1:%2%3")
+                                 .arg(QLatin1String(seb::e2e::LmsServer::Host))
+                                 .arg(serverPort)
+                                 .arg(QLatin1String(seb::e2e::LmsServer::CoursePath));
+    QJsonObject config;
+    config["startUrl"] = startUrl;
+    config["allowedDomains"] = QJsonArray{QLatin1String(seb::e2e::LmsServer::Host)};
+    config["startLoad"] = QJsonObject{{"spreadMs", 0}, {"maxRetries", 0}};
+    if (useProxy) {
+        config["proxy"] = QJsonObject{
+            {"mode", "fixed"},
+            {"server", QString("127.0.0.1:%1").arg(proxyPort)},
+            {"bypass", QJsonArray{QString("cdn.%1").arg(QLatin1String(seb::e2e::LmsServer::Host))}},
+        };
+    } else {
+        // A proxy from the environment would not reach the local *.test hosts
+        config["proxy"] = QJsonObject{{"mode", "direct"}};
+    }
+    const QString configPath = dataDir.filePath("policy.json");
+    QFile configFile(configPath);
+    if (!configFile.open(QIODevice::WriteOnly) || configFile.write(QJsonDocument(config).toJson()) < 0) {
+        std::fprintf(stderr, "Failed to write %s\n", qPrintable(configPath));
+        return 1;
+    }
+    configFile.close();
+
+    seb::core::ConfigLoadResult result = seb::core::ConfigLoader::loadFromFile(configPath);
+    if (!result.success) {
+        std::fprintf(stderr, "Failed to load the policy: %s\n", qPrintable(result.errorMessage));
+        return 1;
+    }
+    seb::core::ProxyConfig::apply(result.policy.proxy);
+    seb::web::SebSchemeHandler::registerScheme();
+
+    // Chromium switches go through argv: *.test resolves to the local
+    // server, whose self-signed certificate is accepted
+    std::vector<QByteArray> chromiumArgs = {
+        QByteArray(argv[0]),
+        QByteArrayLiteral("--host-resolver-rules=MAP *.test 127.0.0.1"),
+        QByteArrayLiteral("--ignore-certificate-errors"),
+    };
+    std::vector<char*> appArgv;
+    for (QByteArray& arg : chromiumArgs) {
+        appArgv.push_back(arg.data());
+    }
+    int appArgc = int(appArgv.size());
+    appArgv.push_back(nullptr);
+
+    QApplication app(appArgc, appArgv.data());
+    app.setApplicationName("seb-e2e");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless end-to-end page load harness for seb-linux");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption subresourcesOption("subresources", "Subresources on the course page (default: 300)", "count", "300");
+    parser.addOption(subresourcesOption);
+    QCommandLineOption blockedEveryOption("blocked-every", "Every n-th subresource is on a blocked host (default: 5, 0: none)", "n", "5");
+    parser.addOption(blockedEveryOption);
+    QCommandLineOption timeoutOption("timeout", "Give up after <ms> (default: 60000)", "ms", "60000");
+    parser.addOption(timeoutOption);
+    QCommandLineOption lowMemoryOption("low-memory", "Apply the lowMemory resource profile");
+    parser.addOption(lowMemoryOption);
+    QCommandLineOption loadsOption("loads", "Load the course page <n> times (default: 1)", "n", "1");
+    parser.addOption(loadsOption);
+    QCommandLineOption proxyOption("proxy", "Route lms.test through a local caching proxy, bypassing cdn.lms.test");
+    parser.addOption(proxyOption);
+    QCommandLineOption jsonOption("json", "Also write the report to <file>", "file");
+    parser.addOption(jsonOption);
+
+    parser.process(arguments);
+
+    // Keep the profile away from the real user dirs
+    QStandardPaths::setTestModeEnabled(true);
+    qInstallMessageHandler(quietMessageHandler);
+
+    const int subresources = qMax(0, parser.value(subresourcesOption).toInt());
+    const int blockedEvery = qMax(0, parser.value(blockedEveryOption).toInt());
+    const int loads = qMax(1, parser.value(loadsOption).toInt());
+
+    // The server gets its own thread so it does not compete with the UI thread
+    QThread serverThread;
+    seb::e2e::LmsServer* server = new seb::e2e::LmsServer(subresources, blockedEvery);
+    server->moveToThread(&serverThread);
+    QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+    serverThread.start();
+
+    QString error;
+    bool listening = false;
+    QMetaObject::invokeMethod(server, [server, serverSocket, &listening, &error]() {
+        listening = server->listen(serverSocket, &error);
+    }, Qt::BlockingQueuedConnection);
+    if (!listening) {
+        std::fprintf(stderr, "Failed to start the HTTPS server: %s\n", qPrintable(error));
+        serverThread.quit();
+        serverThread.wait();
+        return 1;
+    }
+
+    // The proxy blocks on upstream fetches, so it gets a thread of its own too
+    QThread proxyThread;
+    seb::e2e::CachingProxy* proxy = nullptr;
+    if (useProxy) {
+        proxy = new seb::e2e::CachingProxy;
+        proxy->moveToThread(&proxyThread);
+        QObject::connect(&proxyThread, &QThread::finished, proxy, &QObject::deleteLater);
+        proxyThread.start();
+        QMetaObject::invokeMethod(proxy, [proxy, proxySocket, &listening, &error]() {
+            listening = proxy->listen(proxySocket, &error);
+        }, Qt::BlockingQueuedConnection);
+        if (!listening) {
+            std::fprintf(stderr, "Failed to start the proxy: %s\n", qPrintable(error));
+            proxyThread.quit();
+            proxyThread.wait();
+            serverThread.quit();
+            serverThread.wait();
+            return 1;
+        }
+    }
+
+    // Total RSS of the browser and its WebEngine processes, sampled while loading
+    qint64 peakTotalRssKb = 0;
+    int peakProcessCount = 0;
+    QTimer memorySampler;
+    memorySampler.setInterval(50);
+    QObject::connect(&memorySampler, &QTimer::timeout, [&peakTotalRssKb, &peakProcessCount]() {
+        const QList<seb::core::ResourceProfile::ProcessMemory> processes = seb::core::ResourceProfile::processMemory();
+        qint64 total = 0;
+        for (const auto& process : processes) {
+            total += process.residentKb;
+        }
+        if (total > peakTotalRssKb) {
+            peakTotalRssKb = total;
+            peakProcessCount = int(processes.size());
+        }
+    });
+    memorySampler.start();
+
+    QElapsedTimer clock;
+    clock.start();
+    QList<qint64> loadTimesMs;
+    bool loadOk = true;
+
+    seb::web::MainWindow window(result.policy);
+    if (!window.startupError().isEmpty()) {
+        std::fprintf(stderr, "%s\n", qPrintable(window.startupError()));
+        return 1;
+    }
+    QWebEngineView* view = window.findChild<QWebEngineView*>();
+    if (!view) {
+        std::fprintf(stderr, "MainWindow has no web view\n");
+        return 1;
+    }
+    QObject::connect(view, &QWebEngineView::loadFinished, &app, [&](bool ok) {
+        if (loadTimesMs.size() >= loads || view->url().host() != QLatin1String(seb::e2e::LmsServer::Host)) {
+            return;
+        }
+        loadTimesMs.append(clock.elapsed());
+        loadOk = loadOk && ok;
+        if (loadTimesMs.size() < loads) {
+            // Same browser, but the no-store responses are fetched again
+            clock.restart();
+            view->reload();
+            return;
+        }
+        // Let requests issued by the load event finish
+        QTimer::singleShot(500, &app, &QCoreApplication::quit);
+    });
+    QTimer::singleShot(parser.value(timeoutOption).toInt(), &app, &QCoreApplication::quit);
+    window.show();
+
+    app.exec();
+    memorySampler.stop();
+
+    const seb::core::Metrics::RequestTotals totals = seb::core::Metrics::instance().requestTotals();
+    const quint64 requests = totals.allowed + totals.blocked;
+    const int expectedBlocked = server->expectedBlocked() * loads;
+    const qint64 firstLoadMs = loadTimesMs.isEmpty() ? -1 : loadTimesMs.first();
+
+    QJsonObject interceptor;
+    interceptor["requests"] = double(requests);
+    interceptor["blocked"] = double(totals.blocked);
+    interceptor["totalTimeMs"] = totals.totalNs / 1e6;
+    interceptor["meanLatencyUs"] = requests ? totals.totalNs / 1e3 / double(requests) : 0.0;
+    interceptor["requestsPerSecond"] = totals.totalNs ? double(requests) * 1e9 / double(totals.totalNs) : 0.0;
+
+    QJsonObject memory;
+    memory["peakTotalRssKb"] = double(peakTotalRssKb);
+    memory["processesAtPeak"] = peakProcessCount;
+    memory["browserPeakRssKb"] = double(peakRssKb());
+
+    QJsonObject report;
+    report["subresources"] = subresources;
+    report["expectedBlocked"] = expectedBlocked;
+    report["lowMemory"] = parser.isSet(lowMemoryOption);
+    report["loads"] = loads;
+    report["loadSucceeded"] = loadOk;
+    report["timeToFirstLoadMs"] = double(firstLoadMs);
+    QJsonArray loadTimes;
+    for (qint64 ms : loadTimesMs) {
+        loadTimes.append(double(ms));
+    }
+    report["loadTimesMs"] = loadTimes;
+    report["serverRequests"] = double(server->servedRequests());
+    report["interceptor"] = interceptor;
+    report["memory"] = memory;
+
+    // Later loads should come from the proxy's cache; the bypassed CDN never
+    // goes through it
+    bool proxyOk = true;
+    if (proxy) {
+        QJsonArray hosts;
+        for (const QByteArray& host : proxy->tunnelledHosts()) {
+            hosts.append(QString::fromLatin1(host));
+        }
+        const QString cdnHost = QString("cdn.%1").arg(QLatin1String(seb::e2e::LmsServer::Host));
+        const quint64 hits = proxy->hits();
+        const quint64 misses = proxy->misses();
+        proxyOk = hosts.contains(QLatin1String(seb::e2e::LmsServer::Host)) && !hosts.contains(cdnHost)
+               && misses > 0 && hits >= misses * quint64(loads - 1);
+
+        QJsonObject proxyReport;
+        proxyReport["hits"] = double(hits);
+        proxyReport["misses"] = double(misses);
+        proxyReport["hitRatio"] = hits + misses ? double(hits) / double(hits + misses) : 0.0;
+        proxyReport["tunnelledHosts"] = hosts;
+        report["proxy"] = proxyReport;
+
+        proxyThread.quit();
+        proxyThread.wait();
+    }
+
+    serverThread.quit();
+    serverThread.wait();
+
+    const QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    if (parser.isSet(jsonOption)) {
+        QFile out(parser.value(jsonOption));
+        if (!out.open(QIODevice::WriteOnly) || out.write(json) < 0) {
+            std::fprintf(stderr, "Failed to write %s\n", qPrintable(parser.value(jsonOption)));
+            return 1;
+        }
+    }
+
+    if (loadTimesMs.size() < loads || !loadOk) {
+        std::fprintf(stderr, "The course page did not load\n");
+        return 1;
+    }
+    if (totals.blocked < quint64(expectedBlocked)) {
+        std::fprintf(stderr, "Expected at least %d blocked requests, got %llu\n",
+                     expectedBlocked, static_cast<unsigned long long>(totals.blocked));
+        return 2;
+    }
+    if (!proxyOk) {
+        std::fprintf(stderr, "The proxy did not serve later loads from its cache\n");
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "ConfigLoader.h"
+#include "PolicyBlob.h"
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+using seb::core::ConfigLoader;
+using seb::core::ConfigLoadResult;
+using seb::core::Policy;
+using seb::core::PolicyBlob;
+
+// Value checks shared by JSON configurations and compiled policies
+class TestConfigLoader : public QObject {
+    Q_OBJECT
+
+private slots:
+    void jsonRangeChecks_data();
+    void jsonRangeChecks();
+    void validBlobLoads();
+    void blobRangeChecks_data();
+    void blobRangeChecks();
+
+private:
+    QTemporaryDir m_dir;
+
+    QString writeFile(const QString& name, const QByteArray& data);
+};
+
+QString TestConfigLoader::writeFile(const QString& name, const QByteArray& data) {
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        return QString();
+    }
+    return path;
+}
+
+void TestConfigLoader::jsonRangeChecks_data() {
+    QTest::addColumn<QByteArray>("settings");
+    QTest::addColumn<QString>("field");
+
+    QTest::newRow("concurrency") << QByteArray(R"("prefetch": {"concurrency": 0})") << "prefetch.concurrency";
+    QTest::newRow("intervalMs") << QByteArray(R"("metrics": {"intervalMs": 0})") << "metrics.intervalMs";
+    QTest::newRow("httpCacheMb") << QByteArray(R"("resources": {"httpCacheMb": 4096})") << "resources.httpCacheMb";
+    QTest::newRow("backoff")
+        << QByteArray(R"("startLoad": {"initialBackoffMs": 5000, "maxBackoffMs": 1000})") << "startLoad.maxBackoffMs";
+    QTest::newRow("proxyServer") << QByteArray(R"("proxy": {"mode": "direct", "server": "cache:3128"})")
+                                 << "proxy.server";
+}
+
+void TestConfigLoader::jsonRangeChecks() {
+    QFETCH(QByteArray, settings);
+    QFETCH(QString, field);
+
+    const QString path = writeFile("config.json", R"({"startUrl": "https://lms.test/", )" + settings + "}");
+    const ConfigLoadResult result = ConfigLoader::loadFromFile(path);
+    QVERIFY(!result.success);
+    QVERIFY2(result.errorMessage.contains(field), qPrintable(result.errorMessage));
+}
+
+void TestConfigLoader::validBlobLoads() {
+    const QString json = writeFile("valid.json", R"({"startUrl": "https://lms.test/", "allowedDomains": ["lms.test"],
+                                                     "prefetch": {"concurrency": 8}})");
+    const ConfigLoadResult source = ConfigLoader::loadFromFile(json);
+    QVERIFY2(source.success, qPrintable(source.errorMessage));
+
+    QString error;
+    const QString blob = writeFile("valid.sebp", PolicyBlob::compile(source.policy, &error));
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+
+    const ConfigLoadResult result = ConfigLoader::loadFromFile(blob);
+    QVERIFY2(result.success, qPrintable(result.errorMessage));
+    QCOMPARE(result.policy.prefetch.concurrency, 8);
+    QVERIFY(result.policy.compiled);
+}
+
+void TestConfigLoader::blobRangeChecks_data() {
+    QTest::addColumn<QString>("field");
+    QTest::newRow("concurrency") << "prefetch.concurrency";
+    QTest::newRow("intervalMs") << "metrics.intervalMs";
+    QTest::newRow("httpCacheMb") << "resources.httpCacheMb";
+    QTest::newRow("startUrl") << "startUrl";
+}
+
+void TestConfigLoader::blobRangeChecks() {
+    QFETCH(QString, field);
+
+    // A blob written without going through the loader, checksum intact
+    Policy policy;
+    policy.startUrl = "https://lms.test/";
+    if (field == "prefetch.concurrency") {
+        policy.prefetch.concurrency = 0;
+    } else if (field == "metrics.intervalMs") {
+        policy.metrics.intervalMs = 0;
+    } else if (field == "resources.httpCacheMb") {
+        policy.resources.httpCacheMb = 1 << 30;
+    } else {
+        policy.startUrl = "http://lms.test/";
+    }
+
+    QString error;
+    const QString path = writeFile("edited.sebp", PolicyBlob::compile(policy, &error));
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QVERIFY(PolicyBlob::open(path));
+
+    const ConfigLoadResult result = ConfigLoader::loadFromFile(path);
+    QVERIFY(!result.success);
+    QVERIFY2(result.errorMessage.contains(field), qPrintable(result.errorMessage));
+}
+
+QTEST_GUILESS_MAIN(TestConfigLoader)
+#include "tst_configloader.moc"
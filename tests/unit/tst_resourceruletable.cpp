@@ -0,0 +1,130 @@
+#include "ResourceRuleTable.h"
+#include <QtTest/QTest>
+
+using seb::core::DomainMatcher;
+using seb::core::ResourceRule;
+using seb::core::ResourceRuleTable;
+using seb::core::ResourceType;
+
+namespace {
+
+ResourceRule rule(const QStringList& types, const QStringList& domains, ResourceRule::Action action,
+                  bool thirdPartyOnly = false) {
+    ResourceRule result;
+    result.types = types;
+    result.domains = domains;
+    result.action = action;
+    result.thirdPartyOnly = thirdPartyOnly;
+    return result;
+}
+
+// Contiguous types are numbered like their slots
+int type(const char16_t* name) {
+    return ResourceType::slotFromName(QStringView(name));
+}
+
+} // namespace
+
+// Per resource type rules and the site used for thirdParty
+class TestResourceRuleTable : public QObject {
+    Q_OBJECT
+
+private slots:
+    void isThirdParty_data();
+    void isThirdParty();
+    void firstMatchWins();
+    void typesWithoutRules();
+    void thirdPartyRules();
+};
+
+void TestResourceRuleTable::isThirdParty_data() {
+    QTest::addColumn<QStringList>("allowedDomains");
+    QTest::addColumn<QString>("page");
+    QTest::addColumn<QString>("host");
+    QTest::addColumn<bool>("thirdParty");
+
+    const QStringList uni = {"uni.edu"};
+    QTest::newRow("same host") << uni << "lms.uni.edu" << "lms.uni.edu" << false;
+    QTest::newRow("sibling under allowed domain") << uni << "lms.uni.edu" << "cdn.uni.edu" << false;
+    QTest::newRow("allowed domain itself") << uni << "lms.uni.edu" << "uni.edu" << false;
+    QTest::newRow("other site") << uni << "lms.uni.edu" << "fonts.example" << true;
+    QTest::newRow("case") << uni << "LMS.uni.edu" << "cdn.UNI.edu" << false;
+
+    // Country code suffixes must not become a site
+    const QStringList uk = {"example.co.uk"};
+    QTest::newRow("co.uk sibling") << uk << "www.example.co.uk" << "static.example.co.uk" << false;
+    QTest::newRow("co.uk other") << uk << "www.example.co.uk" << "tracker.co.uk" << true;
+    QTest::newRow("co.uk suffix") << uk << "example.co.uk" << "co.uk" << true;
+    const QStringList au = {"lms.unimelb.edu.au"};
+    QTest::newRow("edu.au other") << au << "lms.unimelb.edu.au" << "cdn.monash.edu.au" << true;
+    QTest::newRow("edu.au parent") << au << "lms.unimelb.edu.au" << "unimelb.edu.au" << true;
+
+    // The broadest allowed domain decides
+    const QStringList nested = {"lms.uni.edu", "uni.edu"};
+    QTest::newRow("nested entries") << nested << "lms.uni.edu" << "cdn.uni.edu" << false;
+
+    // Pages outside the allowlist are their own site
+    QTest::newRow("unlisted page") << uni << "exam.test" << "cdn.exam.test" << false;
+    QTest::newRow("unlisted page sibling") << uni << "exam.school.test" << "cdn.school.test" << true;
+    QTest::newRow("no allowlist") << QStringList() << "exam.test" << "other.test" << true;
+    QTest::newRow("ip page") << QStringList() << "192.0.2.10" << "192.0.2.10" << false;
+    QTest::newRow("ip other") << QStringList() << "192.0.2.10" << "2.10" << true;
+
+    QTest::newRow("no page") << uni << "" << "fonts.example" << false;
+}
+
+void TestResourceRuleTable::isThirdParty() {
+    QFETCH(QStringList, allowedDomains);
+    QFETCH(QString, page);
+    QFETCH(QString, host);
+    QFETCH(bool, thirdParty);
+
+    const ResourceRuleTable table({}, DomainMatcher(allowedDomains));
+    QCOMPARE(table.isThirdParty(host, page), thirdParty);
+}
+
+void TestResourceRuleTable::firstMatchWins() {
+    const ResourceRuleTable table({
+        rule({"xhr"}, {"api.lms.test"}, ResourceRule::Action::Allow),
+        rule({"xhr", "media"}, {}, ResourceRule::Action::Block),
+        rule({"xhr"}, {}, ResourceRule::Action::Allow),
+    }, DomainMatcher({"lms.test"}));
+
+    QCOMPARE(table.evaluate(type(u"xhr"), u"api.lms.test", u"lms.test"), ResourceRuleTable::Verdict::Allow);
+    QCOMPARE(table.evaluate(type(u"xhr"), u"v2.api.lms.test", u"lms.test"), ResourceRuleTable::Verdict::Allow);
+    QCOMPARE(table.evaluate(type(u"xhr"), u"lms.test", u"lms.test"), ResourceRuleTable::Verdict::Block);
+    QCOMPARE(table.evaluate(type(u"media"), u"api.lms.test", u"lms.test"), ResourceRuleTable::Verdict::Block);
+}
+
+void TestResourceRuleTable::typesWithoutRules() {
+    const ResourceRuleTable empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.evaluate(type(u"font"), u"lms.test", u"lms.test"), ResourceRuleTable::Verdict::NoMatch);
+
+    const ResourceRuleTable table({rule({"media"}, {}, ResourceRule::Action::Block)});
+    QVERIFY(!table.isEmpty());
+    QCOMPARE(table.evaluate(type(u"font"), u"lms.test", u"lms.test"), ResourceRuleTable::Verdict::NoMatch);
+    QCOMPARE(table.evaluate(ResourceType::WebSocket, u"lms.test", u"lms.test"), ResourceRuleTable::Verdict::NoMatch);
+    QCOMPARE(table.evaluate(1000, u"lms.test", u"lms.test"), ResourceRuleTable::Verdict::NoMatch);
+}
+
+void TestResourceRuleTable::thirdPartyRules() {
+    const ResourceRuleTable table({
+        rule({"font"}, {}, ResourceRule::Action::Block, true),
+        rule({"script"}, {"cdn.example"}, ResourceRule::Action::Allow, true),
+        rule({"script"}, {}, ResourceRule::Action::Block, true),
+    }, DomainMatcher({"example.co.uk", "cdn.example"}));
+
+    const QStringView page = u"www.example.co.uk";
+    QCOMPARE(table.evaluate(type(u"font"), u"static.example.co.uk", page), ResourceRuleTable::Verdict::NoMatch);
+    QCOMPARE(table.evaluate(type(u"font"), u"fonts.co.uk", page), ResourceRuleTable::Verdict::Block);
+    QCOMPARE(table.evaluate(type(u"script"), u"cdn.example", page), ResourceRuleTable::Verdict::Allow);
+    QCOMPARE(table.evaluate(type(u"script"), u"ads.co.uk", page), ResourceRuleTable::Verdict::Block);
+    QCOMPARE(table.evaluate(type(u"script"), u"www.example.co.uk", page), ResourceRuleTable::Verdict::NoMatch);
+
+    // Unattributed requests never count as third-party
+    QCOMPARE(table.evaluate(type(u"font"), u"fonts.co.uk", QStringView()), ResourceRuleTable::Verdict::NoMatch);
+}
+
+QTEST_GUILESS_MAIN(TestResourceRuleTable)
+#include "tst_resourceruletable.moc"
@@ -0,0 +1,98 @@
+#include "Sha256.h"
+#include <QtTest/QTest>
+
+using seb::core::Sha256;
+
+namespace {
+
+QByteArray digest(QByteArrayView data, Sha256::Implementation implementation) {
+    Sha256 sha(implementation);
+    sha.addData(data);
+    return sha.result().toHex();
+}
+
+} // namespace
+
+// FIPS 180-2 vectors, streaming and the SHA-NI path
+class TestSha256 : public QObject {
+    Q_OBJECT
+
+private slots:
+    void vectors_data();
+    void vectors();
+    void streaming_data();
+    void streaming();
+    void resetStartsOver();
+    void shaNiMatchesPortable();
+};
+
+void TestSha256::vectors_data() {
+    QTest::addColumn<QByteArray>("message");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("empty") << QByteArray()
+                           << QByteArray("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    QTest::newRow("abc") << QByteArray("abc")
+                         << QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    QTest::newRow("448 bits") << QByteArray("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")
+                              << QByteArray("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    QTest::newRow("million a") << QByteArray(1000000, 'a')
+                               << QByteArray("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+void TestSha256::vectors() {
+    QFETCH(QByteArray, message);
+    QFETCH(QByteArray, expected);
+
+    QCOMPARE(Sha256::hash(message).toHex(), expected);
+    QCOMPARE(digest(message, Sha256::Implementation::Portable), expected);
+}
+
+void TestSha256::streaming_data() {
+    QTest::addColumn<int>("chunkSize");
+
+    for (int chunkSize : {1, 3, 55, 56, 63, 64, 65, 127, 128, 129, 1000}) {
+        QTest::addRow("chunk %d", chunkSize) << chunkSize;
+    }
+}
+
+void TestSha256::streaming() {
+    QFETCH(int, chunkSize);
+
+    // Chunks that straddle block boundaries and the padding at 56 bytes
+    const QByteArray message(1000000, 'a');
+    Sha256 sha;
+    for (qsizetype offset = 0; offset < message.size(); offset += chunkSize) {
+        sha.addData(QByteArrayView(message).sliced(offset, qMin<qsizetype>(chunkSize, message.size() - offset)));
+    }
+    QCOMPARE(sha.result().toHex(),
+             QByteArray("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+}
+
+void TestSha256::resetStartsOver() {
+    Sha256 sha;
+    sha.addData("discarded");
+    sha.reset();
+    sha.addData("abc");
+    QCOMPARE(sha.result().toHex(),
+             QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+}
+
+void TestSha256::shaNiMatchesPortable() {
+    if (!Sha256::isHardwareAccelerated()) {
+        QSKIP("CPU has no SHA extensions");
+    }
+
+    // Every length around the block and padding boundaries, plus multi-block input
+    QByteArray message;
+    for (int length = 0; length <= 300; ++length) {
+        QCOMPARE(digest(message, Sha256::Implementation::Auto),
+                 digest(message, Sha256::Implementation::Portable));
+        message.append(char(length * 31 + 7));
+    }
+    const QByteArray large(1 << 20, '\xa5');
+    QCOMPARE(digest(large, Sha256::Implementation::Auto), digest(large, Sha256::Implementation::Portable));
+}
+
+QTEST_GUILESS_MAIN(TestSha256)
+#include "tst_sha256.moc"
@@ -0,0 +1,145 @@
+#include "KeyboardLockdown.h"
+#include "ShortcutTable.h"
+#include <QtGui/QKeyEvent>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QWidget>
+
+using seb::web::KeyboardLockdown;
+using seb::web::ShortcutTable;
+
+namespace {
+
+// Records the key presses that reach it
+class KeyRecorder : public QWidget {
+public:
+    QList<QKeyCombination> received;
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override {
+        received.append(event->keyCombination());
+    }
+};
+
+} // namespace
+
+// Shortcut lookup and the application-wide filter that applies it
+class TestShortcutTable : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parsesPortableText();
+    void rejectsInvalidText();
+    void validateNamesInvalidEntry();
+    void supersetsMatch();
+    void mostSpecificRuleWins();
+    void quitNeedsModifier();
+
+    void lockdownSwallowsBlocked();
+    void lockdownEmitsQuit();
+};
+
+void TestShortcutTable::parsesPortableText() {
+    ShortcutTable table;
+    QVERIFY(table.add("Ctrl+Shift+I", ShortcutTable::Action::Block));
+    QVERIFY(table.add("F11", ShortcutTable::Action::Block));
+
+    QCOMPARE(table.lookup(Qt::Key_I, Qt::ControlModifier | Qt::ShiftModifier), ShortcutTable::Action::Block);
+    QCOMPARE(table.lookup(Qt::Key_F11, Qt::NoModifier), ShortcutTable::Action::Block);
+    QCOMPARE(table.lookup(Qt::Key_I, Qt::ControlModifier), ShortcutTable::Action::None);
+    QCOMPARE(table.entries().size(), 2);
+}
+
+void TestShortcutTable::rejectsInvalidText() {
+    ShortcutTable table;
+    QVERIFY(!table.add("Ctrl+", ShortcutTable::Action::Block));
+    QVERIFY(!table.add("Ctrl+L, Ctrl+T", ShortcutTable::Action::Block));
+    QVERIFY(!table.add("NotAKey", ShortcutTable::Action::Block));
+    QVERIFY(table.entries().isEmpty());
+}
+
+void TestShortcutTable::validateNamesInvalidEntry() {
+    QVERIFY(ShortcutTable::validate({"Ctrl+L", "Ctrl+Shift+I", "F11"}).isEmpty());
+    QVERIFY(ShortcutTable::validate({}).isEmpty());
+
+    const QString error = ShortcutTable::validate({"Ctrl+L", "Ctrl+", "F11"});
+    QVERIFY(error.contains("blockedShortcuts"));
+    QVERIFY(error.contains("Ctrl+"));
+}
+
+void TestShortcutTable::supersetsMatch() {
+    ShortcutTable table;
+    table.add(Qt::Key_T, Qt::ControlModifier, ShortcutTable::Action::Block);
+
+    QCOMPARE(table.lookup(Qt::Key_T, Qt::ControlModifier | Qt::ShiftModifier), ShortcutTable::Action::Block);
+    QCOMPARE(table.lookup(Qt::Key_T, Qt::ControlModifier | Qt::AltModifier | Qt::MetaModifier),
+             ShortcutTable::Action::Block);
+    QCOMPARE(table.lookup(Qt::Key_T, Qt::NoModifier), ShortcutTable::Action::None);
+    QCOMPARE(table.lookup(Qt::Key_T, Qt::ShiftModifier), ShortcutTable::Action::None);
+
+    // Keypad and similar flags do not affect the match
+    QCOMPARE(table.lookup(Qt::Key_T, Qt::ControlModifier | Qt::KeypadModifier), ShortcutTable::Action::Block);
+}
+
+void TestShortcutTable::mostSpecificRuleWins() {
+    // Added in either order, Ctrl+Shift+Q quits and plain Ctrl+Q is blocked
+    ShortcutTable first;
+    first.add(Qt::Key_Q, Qt::ControlModifier | Qt::ShiftModifier, ShortcutTable::Action::Quit);
+    first.add(Qt::Key_Q, Qt::ControlModifier, ShortcutTable::Action::Block);
+
+    ShortcutTable second;
+    second.add(Qt::Key_Q, Qt::ControlModifier, ShortcutTable::Action::Block);
+    second.add(Qt::Key_Q, Qt::ControlModifier | Qt::ShiftModifier, ShortcutTable::Action::Quit);
+
+    for (const ShortcutTable& table : {first, second}) {
+        QCOMPARE(table.lookup(Qt::Key_Q, Qt::ControlModifier), ShortcutTable::Action::Block);
+        QCOMPARE(table.lookup(Qt::Key_Q, Qt::ControlModifier | Qt::ShiftModifier), ShortcutTable::Action::Quit);
+        QCOMPARE(table.lookup(Qt::Key_Q, Qt::ControlModifier | Qt::ShiftModifier | Qt::AltModifier),
+                 ShortcutTable::Action::Quit);
+        QCOMPARE(table.lookup(Qt::Key_Q, Qt::ControlModifier | Qt::AltModifier), ShortcutTable::Action::Block);
+    }
+}
+
+void TestShortcutTable::quitNeedsModifier() {
+    const ShortcutTable table = ShortcutTable::build({"Ctrl+L"}, true);
+    QCOMPARE(table.lookup(Qt::Key_Q, Qt::ControlModifier), ShortcutTable::Action::Quit);
+    QCOMPARE(table.lookup(Qt::Key_Escape, Qt::NoModifier), ShortcutTable::Action::None);
+    QCOMPARE(table.lookup(Qt::Key_L, Qt::ControlModifier), ShortcutTable::Action::Block);
+
+    const ShortcutTable withoutQuit = ShortcutTable::build({"Ctrl+L"}, false);
+    QCOMPARE(withoutQuit.lookup(Qt::Key_Q, Qt::ControlModifier), ShortcutTable::Action::None);
+}
+
+void TestShortcutTable::lockdownSwallowsBlocked() {
+    KeyRecorder widget;
+    KeyboardLockdown lockdown(ShortcutTable::build({"Ctrl+L", "F11"}, false));
+    lockdown.install();
+
+    QTest::keyClick(&widget, Qt::Key_L, Qt::ControlModifier);
+    QTest::keyClick(&widget, Qt::Key_L, Qt::ControlModifier | Qt::ShiftModifier);
+    QTest::keyClick(&widget, Qt::Key_F11);
+    QTest::keyClick(&widget, Qt::Key_L);
+    QTest::keyClick(&widget, Qt::Key_Escape);
+
+    QCOMPARE(widget.received.size(), 2);
+    QCOMPARE(widget.received[0], QKeyCombination(Qt::Key_L));
+    QCOMPARE(widget.received[1], QKeyCombination(Qt::Key_Escape));
+}
+
+void TestShortcutTable::lockdownEmitsQuit() {
+    KeyRecorder widget;
+    KeyboardLockdown lockdown(ShortcutTable::build({}, true));
+    QSignalSpy quit(&lockdown, &KeyboardLockdown::quitRequested);
+    lockdown.install();
+
+    QTest::keyClick(&widget, Qt::Key_Q, Qt::ControlModifier);
+    QTest::keyClick(&widget, Qt::Key_Escape);
+
+    QCOMPARE(quit.size(), 1);
+    QCOMPARE(widget.received.size(), 1);
+    QCOMPARE(widget.received[0], QKeyCombination(Qt::Key_Escape));
+}
+
+QTEST_MAIN(TestShortcutTable)
+#include "tst_shortcuttable.moc"